@@ -1,6 +1,7 @@
 #include "adc_dac.h"
 
 #include "global_ports.h"
+#include "system_clock.h"
 
 #ifndef NO_ADC__
 
@@ -26,7 +27,7 @@ void enable_adc_clk(void){
     PM->APBCMASK.reg |= 1 << 16;             // PM_APBCMASK enable is in the 16 position
     
     uint32_t temp = 0x17;                 // ID for ADC 0x17 (see table 14-2)
-    temp |= 0<<8;                             // Selection Generic clock generator 0
+    temp |= PERIPH_GCLK<<8;                   // Selection of the fixed peripheral clock generator
     GCLK->CLKCTRL.reg = temp;                 // Setup in the CLKCTRL register
     GCLK->CLKCTRL.reg |= 0x1u << 14;         // enable it.
 }
@@ -91,14 +92,14 @@ void disable_adc(void){
     adc_ptr->CTRLA.reg &= ~0x2;  //ADC block is disabled   
 }
 
-unsigned int read_adc(void){
-
-    // start the conversion
-    adc_ptr->SWTRIG.reg |= 1 << 1u;
-    while(!adc_ptr->INTFLAG.bit.RESRDY);    //wait for conversion to be available
+RAMFUNC void start_adc(void){
+    adc_ptr->SWTRIG.reg = 1 << 1u;  // Plain write, no read of a synchronized register
+}
 
-    return adc_ptr->RESULT.reg; // Extract stored value
-    
+RAMFUNC BOOLEAN__ take_adc(UINT16* result){
+    if(!adc_ptr->INTFLAG.bit.RESRDY)    return FALSE__;    // Not converted yet
+    *result = adc_ptr->RESULT.reg;  // Reading clears RESRDY
+    return TRUE__;
 }
 
 #endif
@@ -123,7 +124,7 @@ void enable_dac_clk(void){
     PM->APBCMASK.reg |= 1 << 18;             // PM_APBCMASK enable is in the 16 position
     
     uint32_t temp = 0x1A;                 // ID for ADC 0x17 (see table 14-2)
-    temp |= 0<<8;                             // Selection Generic clock generator 0
+    temp |= PERIPH_GCLK<<8;                   // Selection of the fixed peripheral clock generator
     GCLK->CLKCTRL.reg = temp;                 // Setup in the CLKCTRL register
     GCLK->CLKCTRL.reg |= 0x1u << 14;         // enable it.
 }
@@ -166,9 +167,10 @@ void disable_dac(void){
 	while (dac_ptr->STATUS.reg & DAC_STATUS_SYNCBUSY);  // Synchronize clock
 }
 
-void write_to_dac(UINT16 val){
-    while(dac->STATUS.reg & DAC_STATUS_SYNCBUSY);
+RAMFUNC BOOLEAN__ write_to_dac(UINT16 val){
+    if(dac->STATUS.reg & DAC_STATUS_SYNCBUSY)   return FALSE__;    // Previous write pending
     dac->DATA.reg = val;
+    return TRUE__;
 }
 
 #endif
\ No newline at end of file
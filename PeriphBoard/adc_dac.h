@@ -9,6 +9,7 @@
 #if !defined(NO_ADC__) || !defined(NO_DAC__)
     #include <asf.h>
     #include "extended_types.h"
+    #include "ram_placement.h"
 #endif
 
 #ifndef NO_ADC__
@@ -34,7 +35,11 @@
     );
     void enable_adc(void);
     void disable_adc(void);
-    unsigned int read_adc(void);
+        // Neither call waits, so both are safe in an interrupt handler.
+        //  Start a conversion, then take its result on a later call;
+        //  take_adc() returns FALSE__ while the conversion is not done.
+    RAMFUNC void start_adc(void);
+    RAMFUNC BOOLEAN__ take_adc(UINT16* result);
 #endif
 
 #ifndef NO_DAC__
@@ -48,7 +53,9 @@
     void configure_dac(UINT8 ref);
     void enable_dac(void);
     void disable_dac(void);
-    void write_to_dac(UINT16 val);
+        // Returns FALSE__ without writing while the previous write is
+        //  still synchronizing, rather than waiting for it
+    RAMFUNC BOOLEAN__ write_to_dac(UINT16 val);
 #endif
 
 #endif
\ No newline at end of file
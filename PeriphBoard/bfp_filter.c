@@ -0,0 +1,68 @@
+#include "bfp_filter.h"
+
+    // Position of the most significant ON bit, or 0 when mag is 0.
+    //  The M0+ has no CLZ instruction, so binary search in five steps
+    //  instead of looping over every bit.
+static RAMFUNC UINT8 find_msob(UINT32 mag){
+    UINT8 pos = 0;
+    if(mag >> 16){  mag >>= 16; pos += 16;  }
+    if(mag >> 8){   mag >>= 8;  pos += 8;   }
+    if(mag >> 4){   mag >>= 4;  pos += 4;   }
+    if(mag >> 2){   mag >>= 2;  pos += 2;   }
+    if(mag >> 1){               pos += 1;   }
+    return pos;
+}
+
+#define ABS32(V)    ((UINT32)((V) < 0 ? -(V) : (V)))
+
+    // Multiply by 2^shift, rounding to nearest. Left shifts go through
+    //  UINT32 since shifting a negative number left is undefined.
+static RAMFUNC INT32 scale_by(INT32 val, INT8 shift){
+    if(shift >= 0)  return (INT32)((UINT32)val << shift);
+    return (val + (1 << (-shift - 1))) >> -shift;
+}
+
+void reset_bfp_biquad(bfp_biquad* filt){
+    filt->x1 = filt->x2 = filt->y1 = filt->y2 = 0;
+    filt->exp = 0;
+}
+
+RAMFUNC INT32 bfp_biquad_step(bfp_biquad* filt, INT32 in){
+    INT32 x0, y0, acc;
+    INT8 shift;
+
+        // Grow the block exponent first if the new sample does
+        //  not fit a mantissa at the current exponent.
+    shift = (INT8)find_msob(ABS32(in)) - BFP_MANT_MSB - filt->exp;
+    if(shift > 0){
+        filt->x1 >>= shift;
+        filt->x2 >>= shift;
+        filt->y1 >>= shift;
+        filt->y2 >>= shift;
+        filt->exp += shift;
+    }
+    x0 = scale_by(in, -filt->exp);
+
+        // 16x16->32 products only
+    acc = (INT32)filt->b0 * (INT16)x0
+        + (INT32)filt->b1 * filt->x1
+        + (INT32)filt->b2 * filt->x2
+        - (INT32)filt->a1 * filt->y1
+        - (INT32)filt->a2 * filt->y2
+        ;
+    y0 = (acc + (1 << (BFP_COEF_FRAC-1))) >> BFP_COEF_FRAC;
+
+        // Renormalize the new delay line as one block. OR-ing the
+        //  magnitudes gives the largest bit position in one search.
+    shift = (INT8)find_msob(ABS32(y0) | ABS32(x0) | ABS32(filt->x1) | ABS32(filt->y1))
+        - BFP_MANT_MSB;
+    if(filt->exp + shift < BFP_EXP_MIN)    shift = BFP_EXP_MIN - filt->exp;
+
+    filt->x2 = (INT16)scale_by(filt->x1, -shift);
+    filt->x1 = (INT16)scale_by(x0, -shift);
+    filt->y2 = (INT16)scale_by(filt->y1, -shift);
+    filt->y1 = (INT16)scale_by(y0, -shift);
+    filt->exp += shift;
+
+    return scale_by(y0, filt->exp - shift);
+}
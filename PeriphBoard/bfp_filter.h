@@ -0,0 +1,56 @@
+#ifndef BLOCK_FLOAT_FILTER_HDR90871236______
+#define BLOCK_FLOAT_FILTER_HDR90871236______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+    // Block floating point biquad.
+    //  The delay line (x[n-1], x[n-2], y[n-1], y[n-2]) is stored as 16-bit
+    //  mantissas sharing one exponent, so every product in the inner loop
+    //  is a 16x16->32 multiply while the state keeps about 14 significant
+    //  bits over a wide dynamic range (value = mantissa * 2^exp).
+    //
+    //  y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+
+    // Coefficients are Q2.14 so |c| must stay below 2.0
+#define BFP_COEF_FRAC   14
+#define BFP_COEF(C)     ((INT16)((C) < 0 \
+                            ? (C)*(1 << BFP_COEF_FRAC) - 0.5 \
+                            : (C)*(1 << BFP_COEF_FRAC) + 0.5))
+    // Mantissas are normalized so that |m| < 2^(BFP_MANT_MSB+1), so the
+    //  accumulator is bounded by sum(|c|) * 2^14 * 2^14. It cannot overflow
+    //  32 bits (with the rounding term added) only while the sum of the
+    //  coefficient magnitudes stays below 8; the notch in filters.h sums
+    //  to about 6.6. BFP_BIQUAD_INIT refuses to compile coefficients that
+    //  break either this bound or |c| < 2.
+#define BFP_MANT_MSB    13
+#define BFP_COEF_SUM_MAX    7.999   // Margin for the rounding of BFP_COEF
+    // Smallest exponent allowed. Negative exponents hold the fraction of an
+    //  input LSB which the narrow notch needs to keep its poles in place.
+#define BFP_EXP_MIN     (-12)
+
+typedef struct{
+    INT16 b0, b1, b2, a1, a2;   // Q2.14 coefficients
+    INT16 x1, x2, y1, y2;       // Delay line mantissas
+    INT8  exp;                  // Shared exponent of the delay line
+} bfp_biquad;
+
+#define BFP_ABS(C)      ((C) < 0 ? -(C) : (C))
+    // Compile time check, a negative array size fails the build
+#define BFP_COEF_CHECK(B0, B1, B2, A1, A2) \
+    (0*sizeof(char[ \
+        BFP_ABS(B0) < 2 && BFP_ABS(B1) < 2 && BFP_ABS(B2) < 2 \
+        && BFP_ABS(A1) < 2 && BFP_ABS(A2) < 2 \
+        && BFP_ABS(B0) + BFP_ABS(B1) + BFP_ABS(B2) + BFP_ABS(A1) + BFP_ABS(A2) \
+            < BFP_COEF_SUM_MAX ? 1 : -1]))
+
+#define BFP_BIQUAD_INIT(B0, B1, B2, A1, A2) \
+    { BFP_COEF(B0) + BFP_COEF_CHECK(B0, B1, B2, A1, A2), \
+      BFP_COEF(B1), BFP_COEF(B2), BFP_COEF(A1), BFP_COEF(A2), \
+      0, 0, 0, 0, 0 }
+
+void reset_bfp_biquad(bfp_biquad* filt);
+    // Filter one integer sample and return the integer output.
+RAMFUNC INT32 bfp_biquad_step(bfp_biquad* filt, INT32 in);
+
+#endif
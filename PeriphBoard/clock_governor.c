@@ -0,0 +1,56 @@
+#include "clock_governor.h"
+
+#include <asf.h>
+#include "system_clock.h"
+
+cycle_stats clock_switch_us;
+
+static volatile UINT32 busy_us;
+static UINT8 last_load;
+static volatile cpu_clock requested_clock;
+
+void configure_clock_governor(void){
+    busy_us = 0;
+    last_load = 0;
+    requested_clock = get_cpu_clock();
+    reset_cycle_stats(&clock_switch_us);
+}
+
+RAMFUNC void governor_busy(UINT32 us){
+    UINT32 primask = __get_PRIMASK();
+    __disable_irq();
+    busy_us += us;
+    __set_PRIMASK(primask);
+}
+
+void clock_governor_update(UINT32 window_us){
+    UINT32 primask = __get_PRIMASK();
+    UINT32 busy;
+
+    __disable_irq();
+    busy = busy_us;
+    busy_us = 0;
+    __set_PRIMASK(primask);
+
+    if(busy > window_us)    busy = window_us;
+        // Scale the window down rather than the busy time up, so the
+        //  product stays within 32 bits
+    last_load = busy / (window_us/100u);
+
+    if(get_cpu_clock() == CPU_CLOCK_8MHZ && last_load > LOAD_HIGH_PCT)
+        requested_clock = CPU_CLOCK_48MHZ;
+    else if(get_cpu_clock() == CPU_CLOCK_48MHZ && last_load < LOAD_LOW_PCT)
+        requested_clock = CPU_CLOCK_8MHZ;
+}
+
+BOOLEAN__ clock_governor_apply(void){
+    cpu_clock clock = requested_clock;
+
+    if(clock == get_cpu_clock())    return FALSE__;
+    update_cycle_stats(&clock_switch_us, set_cpu_clock(clock));
+    return TRUE__;
+}
+
+UINT8 cpu_load(void){
+    return last_load;
+}
@@ -0,0 +1,34 @@
+#ifndef CLOCK_GOVERNOR_HDR2290618______
+#define CLOCK_GOVERNOR_HDR2290618______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+#include "cycle_counter.h"
+
+    // Picks the CPU clock from the measured interrupt load. Interrupt
+    //  handlers report their busy time with governor_busy(); every window
+    //  clock_governor_update() turns that into a load and requests the
+    //  other clock when it crosses a threshold. The switch itself waits
+    //  for the DFLL and GCLK to synchronize, so clock_governor_apply()
+    //  performs it from the main loop, where the sampling interrupt can
+    //  still preempt it. The thresholds are
+    //  six times apart, as the clocks are, so a load that moves the clock
+    //  up does not immediately move it back down.
+
+#define LOAD_HIGH_PCT   60  // At 8 MHz, go to 48 MHz above this
+#define LOAD_LOW_PCT    8   // At 48 MHz, go to 8 MHz below this
+
+    // Microseconds each switch took, see set_cpu_clock()
+extern cycle_stats clock_switch_us;
+
+void configure_clock_governor(void);
+RAMFUNC void governor_busy(UINT32 us);
+    // Call once per window of window_us microseconds, may run in an ISR
+void clock_governor_update(UINT32 window_us);
+    // Call from the main loop. Switches to the requested clock if it
+    //  differs from the current one and returns TRUE__ if it did.
+BOOLEAN__ clock_governor_apply(void);
+    // Load over the last window in percent
+UINT8 cpu_load(void);
+
+#endif
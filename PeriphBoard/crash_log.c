@@ -0,0 +1,116 @@
+#include "crash_log.h"
+
+#include <asf.h>
+#include <stddef.h>
+#include "timebase.h"
+
+NOINIT crash_log crash_log_ram;
+crash_log crash_log_previous;
+
+static crash_log_status previous_status = CRASH_LOG_COLD;
+    // Set by the seal. Writers check it with interrupts masked, so nothing
+    //  lands in the log after the CRC, not even from a writer the seal
+    //  preempted.
+static volatile BOOLEAN__ sealed = FALSE__;
+
+    // Bitwise CRC-32 (IEEE, reflected). Only run at boot and when sealing,
+    //  so the table is not worth its flash.
+static UINT32 crc32(const UINT8* data, UINT32 size){
+    UINT32 crc = 0xFFFFFFFFu;
+    UINT8 bit;
+    while(size--){
+        crc ^= *data++;
+        for(bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+    }
+    return ~crc;
+}
+
+static UINT32 log_crc(const crash_log* log){
+    return crc32((const UINT8*)log, offsetof(crash_log, crc));
+}
+
+crash_log_status crash_log_boot(void){
+    UINT32 boots = 0;
+    UINT32 i;
+
+    if(crash_log_ram.magic == CRASH_LOG_MAGIC){
+        previous_status = log_crc(&crash_log_ram) == crash_log_ram.crc
+            ? CRASH_LOG_SEALED : CRASH_LOG_UNSEALED;
+        crash_log_previous = crash_log_ram;
+        boots = crash_log_ram.boots;
+    }
+    else    previous_status = CRASH_LOG_COLD;
+
+    sealed = FALSE__;
+    for(i = 0; i < sizeof(crash_log); ++i)  ((UINT8*)&crash_log_ram)[i] = 0;
+    crash_log_ram.magic = CRASH_LOG_MAGIC;
+    crash_log_ram.boots = boots + 1;
+    crash_log_ram.reset_cause = PM->RCAUSE.reg;
+    crash_log_event(CRASH_EV_BOOT, crash_log_ram.reset_cause);
+    return previous_status;
+}
+
+crash_log_status crash_log_previous_status(void){
+    return previous_status;
+}
+
+RAMFUNC void crash_log_event(crash_event_id id, UINT16 data){
+    UINT32 primask = __get_PRIMASK();
+    UINT32 stamp = timebase_now();
+    crash_event* ev;
+
+    __disable_irq();
+    if(!sealed){
+        ev = &crash_log_ram.ring[crash_log_ram.head++ & (CRASH_RING_SIZE - 1)];
+        ev->stamp = stamp;
+        ev->data = data;
+        ev->id = id;
+    }
+    __set_PRIMASK(primask);
+}
+
+RAMFUNC void crash_log_isr_time(UINT32 us){
+    UINT32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    if(!sealed && us > crash_log_ram.max_isr_us)    crash_log_ram.max_isr_us = us;
+    __set_PRIMASK(primask);
+}
+
+RAMFUNC void crash_log_overruns(UINT32 overruns){
+    UINT32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    if(!sealed) crash_log_ram.overruns = overruns;
+    __set_PRIMASK(primask);
+}
+
+void crash_log_seal(crash_cause cause, const UINT32* frame){
+    UINT32 primask = __get_PRIMASK();
+    UINT8 i;
+
+    __disable_irq();
+    if(sealed){
+        __set_PRIMASK(primask);
+        return;
+    }
+    crash_log_ram.cause = cause;
+    if(!IS_NULL(frame))
+        for(i = 0; i < sizeof(exception_frame)/sizeof(UINT32); ++i)
+            ((UINT32*)&crash_log_ram.frame)[i] = frame[i];
+    crash_log_ram.crc = log_crc(&crash_log_ram);
+    sealed = TRUE__;
+    __set_PRIMASK(primask);
+}
+
+    // Called from HardFault_Handler with the exception frame
+void hard_fault_dump(UINT32* frame){
+    crash_log_event(CRASH_EV_HARDFAULT, 0);
+    crash_log_seal(CRASH_CAUSE_HARDFAULT, frame);
+    NVIC_SystemReset();     // Warm reset keeps the log
+}
+
+#ifdef CRASH_LOG
+STACKED_FRAME_HANDLER(HardFault_Handler, hard_fault_dump)
+#endif
@@ -0,0 +1,109 @@
+#ifndef CRASH_LOG_NOINIT_HDR7419305______
+#define CRASH_LOG_NOINIT_HDR7419305______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+// Comment out the below macro to stop logging. The previous run's log is
+//  in crash_log_previous after startup. Needs a .noinit section in the
+//  linker script. Without it, a HardFault stops in the default handler,
+//  where the debugger can inspect it, instead of sealing the log and
+//  resetting.
+#define CRASH_LOG
+
+    // Post-mortem log in NOINIT RAM (see ram_placement.h). It holds a ring
+    //  of recent events, the longest sampling interrupt, the overrun count
+    //  and, after a HardFault or watchdog early warning, the registers of
+    //  the code that was running. Logging is plain stores with interrupts
+    //  briefly masked; the CRC is only computed when the log is sealed
+    //  on the way to a reset, so a log that checks out tells which kind of
+    //  failure ended the previous run. Once sealed, the log ignores all
+    //  further writes until the next crash_log_boot().
+    //
+    //  crash_log_boot() must run before any other call, once the timebase
+    //  is configured (event stamps come from it). It checks the log
+    //  left by the previous run, keeps a copy in crash_log_previous and
+    //  starts a fresh log.
+
+#define CRASH_LOG_MAGIC     0x43524C47u     // "CRLG"
+#define CRASH_RING_SIZE     16              // Power of two
+
+typedef enum{
+    CRASH_EV_BOOT = 1,      // data: PM->RCAUSE
+    CRASH_EV_OVERRUN,       // data: overrun total, low 16 bits (the
+                            //  full total is in crash_log.overruns)
+    CRASH_EV_CLOCK,         // data: new cpu_clock
+    CRASH_EV_POWER_MODE,    // data: new mode mask
+    CRASH_EV_BURST,         // data: burst output
+    CRASH_EV_WDT_WARNING,   // data: missing heartbeats
+    CRASH_EV_HARDFAULT      // data: 0
+} crash_event_id;
+
+typedef enum{
+    CRASH_CAUSE_NONE = 0,
+    CRASH_CAUSE_WATCHDOG,
+    CRASH_CAUSE_HARDFAULT
+} crash_cause;
+
+typedef struct{
+    UINT32 stamp;           // timebase_now()
+    UINT16 data;
+    UINT8 id;
+} crash_event;
+
+typedef struct{
+    UINT32 r0, r1, r2, r3, r12, lr, pc, xpsr;   // As stacked on exception entry
+} exception_frame;
+
+typedef struct{
+    UINT32 magic;
+    UINT32 boots;           // Runs since the log was last found invalid
+    UINT32 reset_cause;     // PM->RCAUSE at the start of this run
+    UINT32 max_isr_us;      // Longest TC6 interrupt
+    UINT32 overruns;
+    UINT32 head;            // Total events, the ring holds the last ones
+    crash_event ring[CRASH_RING_SIZE];
+    UINT32 cause;           // crash_cause of the seal
+    exception_frame frame;
+    UINT32 crc;             // CRC-32 of everything above, set by the seal
+} crash_log;
+
+typedef enum{
+    CRASH_LOG_COLD = 0,     // No previous log (power on or corrupted)
+    CRASH_LOG_UNSEALED,     // Previous run reset without sealing the log
+    CRASH_LOG_SEALED        // Previous run sealed it, cause is valid
+} crash_log_status;
+
+extern NOINIT crash_log crash_log_ram;
+extern crash_log crash_log_previous;
+
+crash_log_status crash_log_boot(void);
+crash_log_status crash_log_previous_status(void);
+RAMFUNC void crash_log_event(crash_event_id id, UINT16 data);
+RAMFUNC void crash_log_isr_time(UINT32 us);
+RAMFUNC void crash_log_overruns(UINT32 overruns);
+    // Record cause and registers and compute the CRC. frame may be NULL.
+    //  Only the first seal after crash_log_boot() takes effect.
+void crash_log_seal(crash_cause cause, const UINT32* frame);
+
+    // Defines exception handler NAME that calls void C_FUNCTION(UINT32*)
+    //  with the exception frame of the interrupted code. Bit 2 of
+    //  EXC_RETURN tells which stack it was pushed on.
+#define STACKED_FRAME_HANDLER(NAME, C_FUNCTION) \
+    __attribute__((naked)) void NAME(void){ \
+        __asm volatile( \
+            "   movs r0, #4     \n" \
+            "   mov r1, lr      \n" \
+            "   tst r0, r1      \n" \
+            "   beq 1f          \n" \
+            "   mrs r0, psp     \n" \
+            "   b 2f            \n" \
+            "1: mrs r0, msp     \n" \
+            "2: ldr r1, =" #C_FUNCTION "\n" \
+            "   bx r1           \n" \
+            "   .align 2        \n" \
+            "   .ltorg          \n" \
+        ); \
+    }
+
+#endif
@@ -0,0 +1,25 @@
+#include "cycle_counter.h"
+
+void configure_cycle_counter(void){
+    SysTick->CTRL = 0;                  // Stop the counter while reloading
+    SysTick->LOAD = CYCLE_COUNTER_MASK; // Count through the full 24 bits
+    SysTick->VAL  = CYCLE_COUNTER_MASK;
+    SysTick->CTRL =
+          SysTick_CTRL_ENABLE_Msk       // Start counting
+        | SysTick_CTRL_CLKSOURCE_Msk    // Run from the CPU clock
+        ;                               // No interrupt on wrap around
+}
+
+void reset_cycle_stats(cycle_stats* stats){
+    stats->last = 0;
+    stats->min = 0xFFFFFFFFu;
+    stats->max = 0;
+    stats->count = 0;
+}
+
+RAMFUNC void update_cycle_stats(cycle_stats* stats, UINT32 cycles){
+    stats->last = cycles;
+    if(cycles < stats->min) stats->min = cycles;
+    if(cycles > stats->max) stats->max = cycles;
+    ++stats->count;
+}
@@ -0,0 +1,30 @@
+#ifndef CYCLE_COUNTER_SYSTICK_HDR7723049182______
+#define CYCLE_COUNTER_SYSTICK_HDR7723049182______
+
+#include <asf.h>
+#include "extended_types.h"
+#include "ram_placement.h"
+
+    // SysTick is a 24-bit down counter clocked by the CPU clock.
+    //  It is left free running so any code path can timestamp
+    //  itself with a single register read.
+#define CYCLE_COUNTER_MASK  0x00FFFFFFu
+#define CYCLES_NOW()        (CYCLE_COUNTER_MASK - SysTick->VAL)
+    // Cycles from START to END. Only valid for spans shorter than
+    //  2^24 cycles (about 2 s at 8 MHz).
+#define CYCLES_BETWEEN(START, END)  (((END) - (START)) & CYCLE_COUNTER_MASK)
+
+    // Running statistics over a series of cycle measurements.
+    //  Jitter of a periodic event is (max - min).
+typedef struct{
+    UINT32 last;
+    UINT32 min;
+    UINT32 max;
+    UINT32 count;
+} cycle_stats;
+
+void configure_cycle_counter(void);
+void reset_cycle_stats(cycle_stats* stats);
+RAMFUNC void update_cycle_stats(cycle_stats* stats, UINT32 cycles);
+
+#endif
@@ -0,0 +1,109 @@
+#include "event_bus.h"
+
+#include <asf.h>
+#include "cycle_counter.h"
+
+static event pool[EVENT_POOL_SIZE];
+static event* free_list;
+static event* queue_head, *queue_tail;
+static event_handler subscribers[EVENT_TYPE_COUNT][EVENT_MAX_SUBSCRIBERS];
+static volatile UINT32 drops;
+
+#ifdef MEASURE_EVENT_LATENCY
+    // Cycles from publish to the start of delivery
+cycle_stats event_latency;
+#endif
+
+void configure_event_bus(void){
+    UINT8 i, j;
+    free_list = NULL;
+    for(i = 0; i < EVENT_POOL_SIZE; ++i){
+        pool[i].next = free_list;
+        free_list = &pool[i];
+    }
+    queue_head = queue_tail = NULL;
+    for(i = 0; i < EVENT_TYPE_COUNT; ++i)
+        for(j = 0; j < EVENT_MAX_SUBSCRIBERS; ++j)
+            subscribers[i][j] = NULL;
+    drops = 0;
+#ifdef MEASURE_EVENT_LATENCY
+    configure_cycle_counter();
+    reset_cycle_stats(&event_latency);
+#endif
+}
+
+BOOLEAN__ event_subscribe(event_type type, event_handler handler){
+    UINT8 i;
+    for(i = 0; i < EVENT_MAX_SUBSCRIBERS; ++i){
+        if(IS_NULL(subscribers[type][i])){
+            subscribers[type][i] = handler;
+            return TRUE__;
+        }
+    }
+    return FALSE__;
+}
+
+RAMFUNC BOOLEAN__ event_publish(event_type type, UINT32 data){
+        // Keep the caller's interrupt state so this nests from any context
+    UINT32 primask = __get_PRIMASK();
+    event* ev;
+
+    __disable_irq();
+    ev = free_list;
+    if(IS_NULL(ev)){
+        ++drops;
+        __set_PRIMASK(primask);
+        return FALSE__;
+    }
+    free_list = ev->next;
+
+    ev->type = type;
+    ev->data = data;
+    ev->next = NULL;
+#ifdef MEASURE_EVENT_LATENCY
+    ev->stamp = CYCLES_NOW();
+#endif
+    if(IS_NULL(queue_tail)) queue_head = ev;
+    else                    queue_tail->next = ev;
+    queue_tail = ev;
+    __set_PRIMASK(primask);
+    return TRUE__;
+}
+
+UINT8 event_dispatch(void){
+        // Keep the caller's interrupt state, as event_publish() does
+    UINT32 primask = __get_PRIMASK();
+    UINT8 delivered = 0, i;
+    event* ev;
+    event_handler handler;
+
+    for(;;){
+            // Only the list manipulation is done with interrupts off
+        __disable_irq();
+        ev = queue_head;
+        if(!IS_NULL(ev)){
+            queue_head = ev->next;
+            if(IS_NULL(queue_head)) queue_tail = NULL;
+        }
+        __set_PRIMASK(primask);
+        if(IS_NULL(ev)) return delivered;
+
+#ifdef MEASURE_EVENT_LATENCY
+        update_cycle_stats(&event_latency, CYCLES_BETWEEN(ev->stamp, CYCLES_NOW()));
+#endif
+        for(i = 0; i < EVENT_MAX_SUBSCRIBERS; ++i){
+            handler = subscribers[ev->type][i];
+            if(!IS_NULL(handler))   handler((event_type)ev->type, ev->data);
+        }
+
+        __disable_irq();
+        ev->next = free_list;
+        free_list = ev;
+        __set_PRIMASK(primask);
+        ++delivered;
+    }
+}
+
+UINT32 event_drops(void){
+    return drops;
+}
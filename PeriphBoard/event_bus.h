@@ -0,0 +1,54 @@
+#ifndef STATIC_EVENT_BUS_HDR6623017______
+#define STATIC_EVENT_BUS_HDR6623017______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+    // Publish/subscribe between interrupts and the main loop.
+    //  Events come from a fixed pool with an O(1) free list, so nothing
+    //  is ever allocated from the heap. Publishing is safe from any
+    //  interrupt; subscribers run from event_dispatch() in the main loop,
+    //  in publishing order.
+
+// Uncomment the below macro to stamp every event when published and
+//  record the publish to delivery latency (CPU cycles) in event_latency.
+//#define MEASURE_EVENT_LATENCY
+
+#define EVENT_POOL_SIZE         16
+#define EVENT_MAX_SUBSCRIBERS   4   // Per event type
+
+typedef enum{
+    EVENT_KEYPRESS = 0,     // data: key code
+    EVENT_OVERRUN,          // data: total overrun count
+    EVENT_TRIGGER,          // data: sample value that hit the trigger
+    EVENT_CONFIG,           // data: new configuration word
+    EVENT_TYPE_COUNT
+} event_type;
+
+typedef struct event event;
+struct event{
+    event* next;
+    UINT32 data;
+#ifdef MEASURE_EVENT_LATENCY
+    UINT32 stamp;           // CYCLES_NOW() at publish
+#endif
+    UINT8 type;
+};
+
+typedef void (*event_handler)(event_type type, UINT32 data);
+
+#ifdef MEASURE_EVENT_LATENCY
+    #include "cycle_counter.h"
+extern cycle_stats event_latency;
+#endif
+
+void configure_event_bus(void);
+    // Returns FALSE__ when the table for this type is full
+BOOLEAN__ event_subscribe(event_type type, event_handler handler);
+    // Returns FALSE__ (and counts a drop) when the pool is exhausted
+RAMFUNC BOOLEAN__ event_publish(event_type type, UINT32 data);
+    // Deliver every queued event. Returns how many were delivered.
+UINT8 event_dispatch(void);
+UINT32 event_drops(void);
+
+#endif
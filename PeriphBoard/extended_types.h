@@ -6,6 +6,8 @@
 #include <stdint.h>
 
 #define INT32   int32_t
+#define INT16   int16_t
+#define INT8    int8_t
 #define UINT32  uint32_t
 #define UINT16  uint16_t
 #define UINT8   uint8_t
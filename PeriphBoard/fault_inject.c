@@ -0,0 +1,62 @@
+#include "fault_inject.h"
+#include "utilities.h"
+
+static fault_config faults;
+static UINT32 rng_state = 1;
+
+    // xorshift32: a few shifts and XORs, no multiply or divide
+static RAMFUNC UINT32 next_random(void){
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+    // TRUE__ with the given probability out of 65536
+static RAMFUNC BOOLEAN__ chance(UINT16 prob){
+    return prob && (next_random() & 0xFFFF) < prob;
+}
+
+    // Uniform in [0, range) without a divide (the M0+ has none)
+static RAMFUNC UINT32 random_below(UINT32 range){
+    return ((next_random() >> 16)*range) >> 16;
+}
+
+static RAMFUNC void busy_wait(UINT16 loops){
+    volatile UINT16 i;
+    for(i = 0; i < loops; ++i);
+}
+
+void configure_faults(const fault_config* config){
+    faults = *config;
+    rng_state = faults.seed ? faults.seed : 1;
+}
+
+RAMFUNC UINT32 fault_adc(UINT32 raw, UINT32 res_max){
+    INT32 val = (INT32)raw;
+
+    busy_wait(faults.resrdy_delay);
+
+    if(faults.noise_amp){
+        val += (INT32)random_below(2u*faults.noise_amp + 1u) - faults.noise_amp;
+        if(val < 0)                     val = 0;
+        else if(val > (INT32)res_max)   val = (INT32)res_max;
+    }
+    if(chance(faults.flip_prob)){
+        val ^= 1 << random_below(find_lsob(~res_max));
+    }
+    val |= faults.stuck_high;
+    val &= ~(INT32)faults.stuck_low;
+
+    return (UINT32)val & res_max;
+}
+
+RAMFUNC UINT8 fault_tc_repeat(void){
+    if(chance(faults.miss_prob))    return 0;
+    if(chance(faults.double_prob))  return 2;
+    return 1;
+}
+
+RAMFUNC void fault_dac_stall(void){
+    busy_wait(faults.dac_stall);
+}
@@ -0,0 +1,30 @@
+#ifndef FAULT_INJECTION_HDR3370192______
+#define FAULT_INJECTION_HDR3370192______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+    // Faults applied to the acquisition path. Probabilities are
+    //  out of 65536 per sample. A zeroed config injects nothing.
+    //  Every decision is drawn from one seeded generator, so a run
+    //  with the same seed and input repeats exactly.
+typedef struct{
+    UINT32 seed;                // Must not be 0
+    UINT16 noise_amp;           // Uniform noise in [-noise_amp, noise_amp] LSB
+    UINT16 stuck_high;          // ADC result bits forced to 1
+    UINT16 stuck_low;           // ADC result bits forced to 0
+    UINT16 flip_prob;           // Chance of flipping one random result bit
+    UINT16 resrdy_delay;        // Busy wait loops before the result is used
+    UINT16 miss_prob;           // Chance a TC6 interrupt is dropped
+    UINT16 double_prob;         // Chance a TC6 interrupt is handled twice
+    UINT16 dac_stall;           // Busy wait loops before each DAC write
+} fault_config;
+
+void configure_faults(const fault_config* config);
+    // Corrupt one raw ADC result. The result is clamped to [0, res_max].
+RAMFUNC UINT32 fault_adc(UINT32 raw, UINT32 res_max);
+    // How many times to handle this interrupt: 0 (missed), 1 or 2 (doubled)
+RAMFUNC UINT8 fault_tc_repeat(void);
+RAMFUNC void fault_dac_stall(void);
+
+#endif
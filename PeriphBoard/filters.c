@@ -0,0 +1,44 @@
+#include "filters.h"
+
+#include "utilities.h"
+
+void reset_lpf(lpf_filter* filt){
+    filt->x_prev = filt->y_prev = 0;
+}
+
+RAMFUNC float lpf_step(lpf_filter* filt, float x){
+    const float omega = LPF_OMEGA;
+    float y = (1-omega)*filt->y_prev + omega*filt->x_prev;
+    filt->y_prev = y;
+    filt->x_prev = x;
+    return y;
+}
+
+void reset_notch(notch_filter* filt){
+    UINT8 i;
+    for(i = 0; i < 3; ++i)  filt->x[i] = filt->y[i] = 0;
+}
+
+RAMFUNC float notch_step(notch_filter* filt, float x){
+    float* xs = filt->x, *ys = filt->y;
+    xs[0] = x;
+    ys[0] = 1.79f*ys[1] - 0.8819f*ys[2] + xs[0] - 1.906f*xs[1] + 0.9981*xs[2];
+    ys[2] = ys[1];
+    xs[2] = xs[1];
+    ys[1] = ys[0];
+    xs[1] = xs[0];
+    return ys[0];
+}
+
+RAMFUNC UINT16 float_to_dac(float y, UINT32 res_max){
+    y = mapf(y, 0, res_max, 0, DAC_MAX);
+    if(y < 0)           return 0;
+    if(y > DAC_MAX)     return DAC_MAX;
+    return (UINT16)y;
+}
+
+RAMFUNC UINT16 int_to_dac(INT32 y, UINT32 res_max){
+    if(y < 0)                   y = 0;
+    else if(y > (INT32)res_max) y = (INT32)res_max;
+    return (UINT16)map32(y, 0, res_max, 0, DAC_MAX);
+}
@@ -0,0 +1,50 @@
+#ifndef SAMPLE_FILTERS_HDR1180472______
+#define SAMPLE_FILTERS_HDR1180472______
+
+    // Filters run by the sampling interrupt. Kept free of any
+    //  peripheral access so the exact same code can be built on a
+    //  host (see tools/freq_response.c).
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+#define PI 3.14
+
+    // First order low pass filter
+    //  y[n] = (1-omega)*y[n-1] + omega*x[n-1]
+#define SAMP_FREQ 1000
+#define BW 100
+#define LPF_OMEGA ((float)(BW*2*PI/SAMP_FREQ))
+
+    // Notch filter, 20 Hz bandwidth
+    // H(z) =   z^2 - 1.906*z + 0.9981
+    //          ----------------------
+    //          z^2 - 1.790*z + 0.8819
+#define NOTCH_B1 (-1.906)
+#define NOTCH_B2 0.9981
+#define NOTCH_A1 (-1.79)
+#define NOTCH_A2 0.8819
+
+    // Full scale of the 10-bit DAC
+#define DAC_MAX 1023
+
+typedef struct{
+    float x_prev, y_prev;
+} lpf_filter;
+
+typedef struct{
+        // Let the index denote the Z delay, e.g. x[1] = X(Z-1)
+    float x[3], y[3];
+} notch_filter;
+
+void reset_lpf(lpf_filter* filt);
+RAMFUNC float lpf_step(lpf_filter* filt, float x);
+void reset_notch(notch_filter* filt);
+RAMFUNC float notch_step(notch_filter* filt, float x);
+
+    // Map a filter output in ADC codes [0, res_max] onto a DAC code.
+    //  Out of range outputs are clamped so they cannot wrap around.
+RAMFUNC UINT16 float_to_dac(float y, UINT32 res_max);
+RAMFUNC UINT16 int_to_dac(INT32 y, UINT32 res_max);
+
+#endif
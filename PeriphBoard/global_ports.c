@@ -14,6 +14,7 @@ Tc* timer2_set, *timer4_set, *timer6_set, *timer7_set;
     // Be careful with TcCount instances since they are part of a union in Tc
 TcCount8* timer2_8;
 TcCount8* timer4_8;
+TcCount32* timer4_32;    // TC4 paired with TC5
 TcCount16* timer2_16;
 TcCount8* timer6_8;
 TcCount8* timer7_8;
@@ -34,6 +35,7 @@ void configure_global_ports(void){
 
     timer4_set = (Tc*)(TC4);
     timer4_8 = (TcCount8*)(&timer4_set->COUNT8);
+    timer4_32 = (TcCount32*)(&timer4_set->COUNT32);
     timer2_16 = (TcCount16*)(&timer2_set->COUNT16);
 
     timer6_set = (Tc*)(TC6);
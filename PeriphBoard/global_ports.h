@@ -19,6 +19,7 @@ extern Tc* timer2_set, *timer4_set, *timer6_set, *timer7_set;
     // Be careful with TcCount instances since they are part of a union in Tc
 extern TcCount8* timer2_8;
 extern TcCount8* timer4_8;
+extern TcCount32* timer4_32;    // TC4 paired with TC5
 extern TcCount16* timer2_16;
 extern TcCount8* timer6_8;
 extern TcCount8* timer7_8;
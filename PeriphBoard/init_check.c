@@ -0,0 +1,24 @@
+#include "init_check.h"
+
+#include <stddef.h>
+
+UINT32 read_golden_reg(const golden_reg* entry){
+        // Read with the register's own width so neighbouring
+        //  registers are not touched.
+    switch(entry->width){
+        case 8:     return *(const volatile UINT8*)entry->addr;
+        case 16:    return *(const volatile UINT16*)entry->addr;
+        default:    return *(const volatile UINT32*)entry->addr;
+    }
+}
+
+UINT8 check_golden_regs(const golden_reg* table, UINT8 count, UINT8* first_bad){
+    UINT8 i, bad = 0;
+    for(i = 0; i < count; ++i){
+        if((read_golden_reg(&table[i]) ^ table[i].expected) & table[i].mask){
+            if(!bad && !IS_NULL(first_bad))   *first_bad = i;
+            ++bad;
+        }
+    }
+    return bad;
+}
@@ -0,0 +1,25 @@
+#ifndef INIT_GOLDEN_CHECK_HDR4418230______
+#define INIT_GOLDEN_CHECK_HDR4418230______
+
+#include "extended_types.h"
+
+    // One register of a golden peripheral image.
+    //  Only the bits in mask are compared, so bits the hardware changes
+    //  on its own (status, sync) can be left out.
+typedef struct{
+    const volatile void* addr;
+    UINT8 width;        // Access size in bits: 8, 16 or 32
+    UINT32 mask;
+    UINT32 expected;
+} golden_reg;
+
+#define GOLDEN_REG(REG, MASK, EXPECTED) \
+    { &(REG), sizeof(REG)*8, (MASK), (EXPECTED) }
+
+    // Compare the live registers against a golden image after the init
+    //  routines have run. Returns the number of mismatches; the index of
+    //  the first one is stored in first_bad (when not NULL).
+UINT8 check_golden_regs(const golden_reg* table, UINT8 count, UINT8* first_bad);
+UINT32 read_golden_reg(const golden_reg* entry);
+
+#endif
@@ -1,6 +1,9 @@
 #include "global_ports.h"
 #include "keypad.h"
 
+#include "timebase.h"
+#include "event_bus.h"
+
 static PortGroup* key_bankA;
 
 void configure_keypad_ports(void){
@@ -21,66 +24,29 @@ void configure_keypad_ports(void){
     }
 }
 
-void check_key(UINT8* row_dest, UINT8* col_dest){
-    static UINT8 cur_row = 0u;
-    // Provide power to one specific row
-    key_bankA->OUT.reg |= 0x000000F0;
-    key_bankA->OUT.reg &= ~(1u << (4u + cur_row));
-        // Extract the four bits we're interested in from
-        //   the keypad.
-    if(!IS_NULL(col_dest))  *col_dest = debounce_keypress();
-    if(!IS_NULL(row_dest))  *row_dest = cur_row;
-
-        // Prepare for the next row. If we were on the last
-        //  row, cycle back to the first row.
-        // Take modulous to retrieve current value of cur_row when
-        //  we were not on the last row. If that is the case,
-        //  reset row_bit to 0.
-    cur_row = (cur_row+1u)%4u;
+void configure_keypad_task(keypad_task_state* task){
+    PT_INIT(&task->thread);
+    task->row = 0;
+    task->cols = 0;
 }
 
-UINT8 debounce_keypress(void){
-    // Triggered the instant the first key press is detected
-    //  Returns the resulting hex number
+PT_THREAD(keypad_task(keypad_task_state* task, UINT8 row)){
+    UINT8 cols = (key_bankA->IN.reg >> 16u) & 0xF;
 
-    UINT8 toreturn = (key_bankA->IN.reg >> 16u) & 0xF;
+    PT_BEGIN(&task->thread);
+    while(1){
+        PT_WAIT_UNTIL(&task->thread, cols);
+        task->row = row;
+        task->cols = cols;
+        task->deadline = timebase_deadline(KEY_DEBOUNCE_US);
 
-        // Check if more than one button in a row was pressed.
-        //  If so, checking for glitches is no longer important.
-    UINT32 counter = 0x0;
-    BOOLEAN__ already_on = FALSE__;
-    for(; counter < 4; ++counter){
-        if(already_on & (toreturn >> counter))  return toreturn;
-        else    already_on = (toreturn >> counter) & 0x1;
-    }
+            // Bounces show up as a changed reading on the same row
+        PT_WAIT_UNTIL(&task->thread,
+            row == task->row && (cols != task->cols || deadline_passed(task->deadline)));
+        if(cols != task->cols)  continue;
 
-    if(!toreturn)   return 0x0;
-#define MAX_JITTER  5
-#define MAX_JITTER2 1000
-#define RELEASE_LIM 7500
-
-    // First, read up to MAX_JITTER times to swallow spikes as button is
-    //  pressed. If no key press was detected in this time, the noise is
-    //  not from a button press.
-    for(counter = 0x0; counter < MAX_JITTER; ++counter){
-        if(!((key_bankA->IN.reg >> 16u) & 0xF))    return 0x0;
+        event_publish(EVENT_KEYPRESS, (task->row << 4u) | task->cols);
+        PT_WAIT_UNTIL(&task->thread, row == task->row && !cols);
     }
-
-    // Now swallow the spikes as the button is released. Do not exit
-    //  until the spikes are no longer detected after MAX_JITTER reads.
-    //  If the user is holding down the button, release manually based
-    //  on RELEASE_LIM.
-    volatile UINT32 release = 0x0;
-    for(
-        counter = 0x0;
-        counter < MAX_JITTER2 && release < RELEASE_LIM;
-        ++counter, ++release
-    ){
-        if((key_bankA->IN.reg >> 16u) & 0xF)    counter = 0x0;
-    }
-
-    return toreturn;
-
-#undef MAX_JITTER
-#undef RELEASE_LIM
-}
\ No newline at end of file
+    PT_END(&task->thread);
+}
@@ -2,9 +2,24 @@
 #define KEYPAD_HEADER_FILEEE823794872938______
 
 #include "extended_types.h"
+#include "pt.h"
+
+#define KEY_DEBOUNCE_US     20000   // Contacts must be stable this long
+
+    // Non-blocking scan that shares the row lines with the SSD digit
+    //  selects: call keypad_task() right after a digit is turned on, with
+    //  the digit index as the row. A debounced press is published as an
+    //  EVENT_KEYPRESS with (row << 4) | column bits.
+typedef struct{
+    pt thread;
+    UINT8 row;          // Row and column bits of the key being debounced
+    UINT8 cols;
+    UINT32 deadline;    // timebase_now() value when the key counts as stable
+} keypad_task_state;
 
 void configure_keypad_ports(void);
-void check_key(UINT8* row_dest, UINT8* col_dest);
-UINT8 debounce_keypress(void);
+
+void configure_keypad_task(keypad_task_state* task);
+PT_THREAD(keypad_task(keypad_task_state* task, UINT8 row));
 
 #endif
\ No newline at end of file
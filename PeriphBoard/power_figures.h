@@ -0,0 +1,37 @@
+#ifndef POWER_FIGURES_HDR5518203______
+#define POWER_FIGURES_HDR5518203______
+
+    // Supply current estimates in microamps at 3.3 V, typical
+    //  datasheet-level figures. Replace them with measurements from the
+    //  board where they matter. tools/fleet_sim.c models the supply
+    //  current from this table.
+
+    // Each gated peripheral while clocked at 8 MHz, in periph_id order
+    //  (see power_gate.h). The ADC and DAC figures are their idle bias;
+    //  conversions and DAC updates add the charges below.
+#define PERIPH_TC4_UA   40
+#define PERIPH_TC5_UA   40
+#define PERIPH_TC6_UA   30
+#define PERIPH_TC7_UA   30
+#define PERIPH_ADC_UA   50
+#define PERIPH_DAC_UA   250
+#define PERIPH_UA_TABLE { PERIPH_TC4_UA, PERIPH_TC5_UA, PERIPH_TC6_UA, \
+                          PERIPH_TC7_UA, PERIPH_ADC_UA, PERIPH_DAC_UA }
+
+    // Extra current while the ADC converts, and how long one 12-bit
+    //  conversion takes at the 1 MHz ADC clock. Averaging repeats it.
+#define ADC_CONVERT_UA      850
+#define ADC_CONVERSION_US   7
+    // Extra current while the DAC output settles after a write
+#define DAC_UPDATE_UA       200
+#define DAC_SETTLE_US       3
+
+    // Core and oscillators
+#define CPU_ACTIVE_UA_PER_MHZ   75      // Running from flash
+#define CPU_IDLE_UA_PER_MHZ     25      // IDLE sleep, clocks running
+#define OSC8M_UA                64      // Feeds PERIPH_GCLK, off in standby
+#define DFLL48M_UA              150     // Only while the CPU runs at 48 MHz
+    // Standby with OSCULP32K, the RTC and the WDT running
+#define STANDBY_UA              4
+
+#endif
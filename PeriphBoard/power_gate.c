@@ -0,0 +1,58 @@
+#include "power_gate.h"
+
+#include <asf.h>
+#include "system_clock.h"
+
+typedef struct{
+    UINT8 apbc_bit;     // Position in PM->APBCMASK (see pg 129)
+    UINT8 gclk_id;      // Generic clock channel (see table 14-2)
+} periph_clock;
+
+static const periph_clock periph_clocks[PERIPH_COUNT] = {
+    {12, 0x15},     // TC4
+    {13, 0x15},     // TC5
+    {14, 0x16},     // TC6
+    {15, 0x16},     // TC7
+    {16, 0x17},     // ADC
+    {18, 0x1A},     // DAC
+};
+
+    // Peripherals currently clocked, all of them once configured
+static UINT16 mode_mask = POWER_MODE_SAMPLING;
+
+static UINT16 gclk_users(UINT8 gclk_id, UINT16 enabled){
+    UINT16 users = 0;
+    UINT8 i;
+    for(i = 0; i < PERIPH_COUNT; ++i)
+        if(periph_clocks[i].gclk_id == gclk_id)  users |= enabled & PERIPH_BIT(i);
+    return users;
+}
+
+void power_set_mode(UINT16 mode){
+    UINT32 primask = __get_PRIMASK();
+    UINT16 changed;
+    UINT8 i;
+
+    __disable_irq();
+    changed = mode ^ mode_mask;
+    for(i = 0; i < PERIPH_COUNT; ++i){
+        if(!(changed & PERIPH_BIT(i)))  continue;
+        if(mode & PERIPH_BIT(i)){
+                // Bus clock first, so the channel can be written
+            PM->APBCMASK.reg |= 1u << periph_clocks[i].apbc_bit;
+            GCLK->CLKCTRL.reg = periph_clocks[i].gclk_id | (PERIPH_GCLK << 8)
+                | (0x1u << 14);    // Enable
+        }
+        else{
+            if(!gclk_users(periph_clocks[i].gclk_id, mode))
+                GCLK->CLKCTRL.reg = periph_clocks[i].gclk_id | (PERIPH_GCLK << 8);
+            PM->APBCMASK.reg &= ~(1u << periph_clocks[i].apbc_bit);
+        }
+    }
+    mode_mask = mode;
+    __set_PRIMASK(primask);
+}
+
+UINT16 power_mode(void){
+    return mode_mask;
+}
@@ -0,0 +1,37 @@
+#ifndef POWER_GATE_HDR9025571______
+#define POWER_GATE_HDR9025571______
+
+#include "extended_types.h"
+
+    // Gates the APBC bus clock and the generic clock channel of every
+    //  peripheral the current mode does not need. Burst mode switches
+    //  between POWER_MODE_SAMPLING and POWER_MODE_IDLE around standby.
+    //  TC4/TC5 and TC6/TC7 share a generic clock channel, which is only
+    //  stopped once both halves are idle. tools/fleet_sim.c --mode
+    //  estimates the supply current of each mode.
+    //  Registers of a gated peripheral cannot be accessed.
+
+typedef enum{
+    PERIPH_TC4 = 0,     // Timebase, low half
+    PERIPH_TC5,         // Timebase, high half
+    PERIPH_TC6,         // Sampling timer
+    PERIPH_TC7,         // Display and timer wheel tick
+    PERIPH_ADC,
+    PERIPH_DAC,
+    PERIPH_COUNT
+} periph_id;
+
+#define PERIPH_BIT(P)   (1u << (P))
+
+    // Peripherals each operating mode keeps clocked
+#define POWER_MODE_SAMPLING ( PERIPH_BIT(PERIPH_TC4) | PERIPH_BIT(PERIPH_TC5) \
+                            | PERIPH_BIT(PERIPH_TC6) | PERIPH_BIT(PERIPH_TC7) \
+                            | PERIPH_BIT(PERIPH_ADC) | PERIPH_BIT(PERIPH_DAC) )
+#define POWER_MODE_DISPLAY  ( PERIPH_BIT(PERIPH_TC4) | PERIPH_BIT(PERIPH_TC5) \
+                            | PERIPH_BIT(PERIPH_TC7) )
+#define POWER_MODE_IDLE     ( PERIPH_BIT(PERIPH_TC4) | PERIPH_BIT(PERIPH_TC5) )
+
+void power_set_mode(UINT16 mode);
+UINT16 power_mode(void);
+
+#endif
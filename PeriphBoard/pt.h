@@ -0,0 +1,54 @@
+#ifndef PROTOTHREADS_HDR8164093______
+#define PROTOTHREADS_HDR8164093______
+
+#include "extended_types.h"
+
+    // Stackless coroutines after Adam Dunkels' protothreads. A task is an
+    //  ordinary function written sequentially between PT_BEGIN and PT_END
+    //  that returns at every wait; the next call jumps straight back to
+    //  the line it waited on. The only state kept is the pt struct
+    //  (2 bytes), so anything that must survive a wait belongs in static
+    //  or caller-owned storage, never in locals.
+    //
+    //  Restrictions that come from the switch based implementation:
+    //  - no switch statement of its own may span a wait
+    //  - break inside the task leaves the hidden switch, use continue or
+    //    PT_EXIT instead
+    //  - at most one wait per source line
+
+typedef struct{
+    UINT16 lc;      // Line to resume at, 0 for the start
+} pt;
+
+#define PT_WAITING  0
+#define PT_YIELDED  1
+#define PT_EXITED   2
+#define PT_ENDED    3
+
+#define PT_THREAD(NAME_ARGS)    UINT8 NAME_ARGS
+
+#define PT_INIT(PT)             ((PT)->lc = 0)
+
+#define PT_BEGIN(PT)            { UINT8 pt_yield = 1; (void)pt_yield; \
+                                  switch((PT)->lc){ case 0:
+
+#define PT_END(PT)              } PT_INIT(PT); return PT_ENDED; }
+
+#define PT_WAIT_UNTIL(PT, COND) do{ (PT)->lc = __LINE__; case __LINE__: \
+                                    if(!(COND)) return PT_WAITING; }while(0)
+
+#define PT_WAIT_WHILE(PT, COND) PT_WAIT_UNTIL(PT, !(COND))
+
+    // Give way for one call, then carry on
+#define PT_YIELD(PT)            do{ pt_yield = 0; (PT)->lc = __LINE__; \
+                                    case __LINE__: \
+                                    if(!pt_yield) return PT_YIELDED; }while(0)
+
+#define PT_RESTART(PT)          do{ PT_INIT(PT); return PT_WAITING; }while(0)
+
+#define PT_EXIT(PT)             do{ PT_INIT(PT); return PT_EXITED; }while(0)
+
+    // TRUE__ while the task has not exited or ended
+#define PT_SCHEDULE(F)          ((F) < PT_EXITED)
+
+#endif
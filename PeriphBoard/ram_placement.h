@@ -0,0 +1,29 @@
+#ifndef RAM_CODE_PLACEMENT_HDR5519203______
+#define RAM_CODE_PLACEMENT_HDR5519203______
+
+// Uncomment the below macro to run the sampling ISR hot path from SRAM.
+//  Once the core clock needs flash wait states, every instruction fetch
+//  from flash stalls, while SRAM is always zero wait state.
+//  Costs the size of every RAMFUNC in both flash (load image) and SRAM.
+//#define HOT_PATH_IN_RAM
+
+#ifdef HOT_PATH_IN_RAM
+        // The ASF linker scripts collect .ramfunc into .relocate, which
+        //  Reset_Handler copies from flash to SRAM together with .data,
+        //  so no extra startup code is needed.
+        // Flash and SRAM are too far apart for a BL, so calls into
+        //  RAMFUNCs are made through a register.
+        // Soft-float helpers (__aeabi_f*) stay in flash.
+    #define RAMFUNC __attribute__((section(".ramfunc"), long_call))
+#else
+    #define RAMFUNC
+#endif
+
+    // Variables the startup code neither copies nor zeroes, so their
+    //  contents survive a warm reset (watchdog, software, reset pin).
+    //  The ASF linker scripts have no such section; add one to the RAM
+    //  region, outside .bss:
+    //      .noinit (NOLOAD) : { . = ALIGN(4); *(.noinit .noinit.*) } > ram
+#define NOINIT __attribute__((section(".noinit")))
+
+#endif
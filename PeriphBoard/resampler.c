@@ -0,0 +1,54 @@
+#include "resampler.h"
+
+void configure_resampler(resampler* rs, UINT32 in_rate, UINT32 out_rate, BOOLEAN__ cubic){
+    UINT8 i;
+    rs->step = (UINT32)(((unsigned long long)in_rate << RESAMPLE_FRAC_BITS)/out_rate);
+    rs->phase = 0;
+    for(i = 0; i < 4; ++i)  rs->hist[i] = 0;
+    rs->cubic = cubic;
+}
+
+    // Interpolate between hist[1] and hist[2] at mu/4096
+static RAMFUNC INT16 interpolate(const INT16* x, INT32 mu){
+    return (INT16)(x[1] + (((INT32)(x[2] - x[1])*mu) >> RESAMPLE_MU_BITS));
+}
+
+static RAMFUNC INT16 interpolate_cubic(const INT16* x, INT32 mu){
+        // Catmull-Rom coefficients, all doubled to avoid halves
+    INT32 c1 = (INT32)x[2] - x[0];
+    INT32 c2 = 2*(INT32)x[0] - 5*(INT32)x[1] + 4*(INT32)x[2] - x[3];
+    INT32 c3 = (INT32)x[3] - x[0] + 3*((INT32)x[1] - x[2]);
+    INT32 y;
+    y = ((c3*mu) >> RESAMPLE_MU_BITS) + c2;
+    y = ((y*mu) >> RESAMPLE_MU_BITS) + c1;
+    y = ((y*mu) >> RESAMPLE_MU_BITS) + 2*(INT32)x[1];
+    y = (y + 1) >> 1;
+    if(y > 32767)   y = 32767;
+    if(y < -32768)  y = -32768;
+    return (INT16)y;
+}
+
+RAMFUNC UINT8 resample_push(resampler* rs, INT16 in, INT16* out, UINT8 max_out){
+    UINT8 count = 0;
+    INT32 mu;
+
+    rs->hist[0] = rs->hist[1];
+    rs->hist[1] = rs->hist[2];
+    rs->hist[2] = rs->hist[3];
+    rs->hist[3] = in;
+
+        // Every output whose position lies in [hist[1], hist[2]).
+        //  Outputs beyond max_out are dropped but keep their timing.
+    while(rs->phase < RESAMPLE_ONE){
+        mu = rs->phase >> (RESAMPLE_FRAC_BITS - RESAMPLE_MU_BITS);
+        if(count < max_out){
+            out[count++] = rs->cubic
+                ? interpolate_cubic(rs->hist, mu)
+                : interpolate(rs->hist, mu);
+        }
+        rs->phase += rs->step;
+    }
+        // Moving on by one input sample
+    rs->phase -= RESAMPLE_ONE;
+    return count;
+}
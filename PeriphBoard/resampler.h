@@ -0,0 +1,36 @@
+#ifndef FRACTIONAL_RESAMPLER_HDR5520913______
+#define FRACTIONAL_RESAMPLER_HDR5520913______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+    // Fixed point fractional sample rate converter.
+    //  A phase accumulator walks through the input at in_rate/out_rate
+    //  input samples per output, and each output is interpolated at its
+    //  fractional position with either
+    //      - linear interpolation (1 multiply per output), or
+    //      - a cubic Farrow structure (4-point Catmull-Rom, 3 multiplies
+    //        per output in Horner form)
+    //  Both interpolate between the two middle samples of a 4 sample
+    //  history, so the delay is 2 input samples in either mode.
+    //  Inputs are INT16; the fractional position is kept to 1/4096 of an
+    //  input sample so every product fits 32 bits.
+
+#define RESAMPLE_FRAC_BITS  16      // Phase accumulator fraction
+#define RESAMPLE_MU_BITS    12      // Interpolation position resolution
+#define RESAMPLE_ONE        (1ul << RESAMPLE_FRAC_BITS)
+
+typedef struct{
+    UINT32 step;        // Input samples per output sample, Q16.16
+    UINT32 phase;       // Position of the next output past hist[1], Q16.16
+    INT16 hist[4];      // Oldest first
+    BOOLEAN__ cubic;
+} resampler;
+
+void configure_resampler(resampler* rs, UINT32 in_rate, UINT32 out_rate, BOOLEAN__ cubic);
+    // Push one input sample and write the outputs that became due into
+    //  out. Returns how many were written. With out_rate <= in_rate that
+    //  is never more than 1; outputs beyond max_out are dropped.
+RAMFUNC UINT8 resample_push(resampler* rs, INT16 in, INT16* out, UINT8 max_out);
+
+#endif
@@ -0,0 +1,48 @@
+#include "rtc_wake.h"
+
+#include <asf.h>
+#include "system_clock.h"
+
+static volatile UINT32 wakeups = 0;
+
+void configure_rtc_wake(UINT32 period_ms){
+    PM->APBAMASK.reg |= 1u << 5;    // RTC clock (page 127)
+
+    GCLK->CLKCTRL.reg = 0x04        // ID for RTC is 0x04  (see table 14-2)
+        | (SLOW_GCLK << 8u)         // Slow generic clock generator
+        | (0x1u << 14);             // enable it.
+
+    RTC->MODE0.CTRL.reg &= ~(1 << 1u);              // Disable
+    while(RTC->MODE0.STATUS.reg & (1 << 7u));
+    RTC->MODE0.CTRL.reg =
+          (0x0 << 8u)   // No prescaler
+        | (0x1 << 7u)   // Clear the count on compare match
+        | (0x0 << 2u)   // Mode 0, 32-bit counter
+        ;
+    RTC->MODE0.COMP[0].reg = period_ms*SLOW_GCLK_HZ/1000u - 1;
+    RTC->MODE0.COUNT.reg = 0;
+    while(RTC->MODE0.STATUS.reg & (1 << 7u));
+
+    RTC->MODE0.INTENSET.reg = 0x1;  // Compare 0
+    RTC->MODE0.INTFLAG.reg = 0x1;
+    NVIC->ISER[0] |= 1 << 3u;       // RTC is interrupt 3
+
+    RTC->MODE0.CTRL.reg |= 1 << 1u;                 // Enable
+    while(RTC->MODE0.STATUS.reg & (1 << 7u));
+}
+
+void enter_standby(void){
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    __DSB();
+    __WFI();
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;     // Later waits only idle
+}
+
+UINT32 rtc_wakeups(void){
+    return wakeups;
+}
+
+void RTC_Handler(void){
+    RTC->MODE0.INTFLAG.reg = 0x1;   // Write one to clear only this flag
+    ++wakeups;
+}
@@ -0,0 +1,17 @@
+#ifndef RTC_WAKE_HDR3386410______
+#define RTC_WAKE_HDR3386410______
+
+#include "extended_types.h"
+
+    // Periodic wake-up from standby. The RTC counts SLOW_GCLK (1.024 kHz
+    //  from OSCULP32K, see system_clock.h), the only clock that keeps
+    //  running in standby, and interrupts on every compare match.
+    //  Everything on OSC8M stops in standby, the timebase included.
+
+    // Wake every period_ms milliseconds (rounded to RTC ticks)
+void configure_rtc_wake(UINT32 period_ms);
+    // Sleep in standby until the next interrupt, normally the RTC
+void enter_standby(void);
+UINT32 rtc_wakeups(void);
+
+#endif
@@ -5,7 +5,7 @@
 
 void configure_ssd_ports(void);
 void display_dig(
-    UINT32 add_delay, UINT8 num, UINT8 select,
+    UINT8 num, UINT8 select,
     BOOLEAN__ show_dot, BOOLEAN__ show_sign
 );
 void turn_off_ssd(void);
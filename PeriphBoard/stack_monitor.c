@@ -0,0 +1,34 @@
+#include "stack_monitor.h"
+
+#include <asf.h>
+
+    // Bounds of the stack reserved by the linker script
+extern UINT32 _sstack;
+extern UINT32 _estack;
+
+    // Words left unpainted below the current stack pointer so
+    //  paint_stack() does not overwrite its own frame.
+#define PAINT_MARGIN 16
+
+void paint_stack(UINT32* base, UINT32* top){
+    while(base < top)   *base++ = STACK_PAINT;
+}
+
+UINT32 stack_high_water(const UINT32* base, const UINT32* top){
+        // Scan up from the bottom for the first word that was overwritten
+    while(base < top && *base == STACK_PAINT)   ++base;
+    return (UINT32)(top - base)*sizeof(UINT32);
+}
+
+void paint_main_stack(void){
+    UINT32* sp = (UINT32*)__get_MSP();
+    paint_stack(&_sstack, sp - PAINT_MARGIN);
+}
+
+UINT32 main_stack_high_water(void){
+    return stack_high_water(&_sstack, &_estack);
+}
+
+UINT32 main_stack_size(void){
+    return (UINT32)(&_estack - &_sstack)*sizeof(UINT32);
+}
@@ -0,0 +1,25 @@
+#ifndef STACK_PAINT_MONITOR_HDR6610928______
+#define STACK_PAINT_MONITOR_HDR6610928______
+
+#include "extended_types.h"
+
+    // Pattern written over unused stack. Words still holding it
+    //  have never been touched since painting.
+#define STACK_PAINT 0xC5C5C5C5u
+
+    // Fill [base, top) with the paint pattern. base is the lowest
+    //  address; the stack grows down from top.
+void paint_stack(UINT32* base, UINT32* top);
+    // Deepest use in bytes of a stack painted with paint_stack()
+UINT32 stack_high_water(const UINT32* base, const UINT32* top);
+
+    // The main stack is also used by every interrupt handler, so its
+    //  high-water mark includes the deepest (nested) ISR use.
+    // Call paint_main_stack() first thing in main(), before any
+    //  interrupt is enabled. Only the area below the caller's frame
+    //  is painted.
+void paint_main_stack(void);
+UINT32 main_stack_high_water(void);
+UINT32 main_stack_size(void);
+
+#endif
@@ -1,6 +1,14 @@
 #include "system_clock.h"
 
 #include <asf.h>
+#include "timebase.h"
+
+    // Factory coarse calibration of the DFLL48M, bits 63:58 of the
+    //  NVM software calibration area
+#define NVM_DFLL_COARSE_POS     58
+#define NVM_DFLL_COARSE_SIZE    6
+
+static cpu_clock current_clock = CPU_CLOCK_8MHZ;
 
 //Simple Clock Initialization
 void Simple_Clk_Init(void)
@@ -42,4 +50,64 @@ void Simple_Clk_Init(void)
     GCLK->GENDIV.reg  = 0x0100;            // Divide by 1 for GCLK #0 (page 104)
 
     GCLK->GENCTRL.reg = 0x030600;           // GCLK#0 enable, Source=6(OSC8M), IDC=1 (page 101)
+
+        // Generic clock #1 feeds the peripherals from OSC8M as well, but is
+        //  never switched, see set_cpu_clock()
+    GCLK->GENDIV.reg  = 0x0001;             // Divide by 1 for GCLK #1
+    GCLK->GENCTRL.reg = 0x030601;           // GCLK#1 enable, Source=6(OSC8M), IDC=1
+    while(GCLK->STATUS.reg & (1 << 7u));    // Synchronize before proceeding
+
+        // Generic clock #2: OSCULP32K divided by 32, kept in standby
+    GCLK->GENDIV.reg  = 0x2 | (32u << 8);
+    GCLK->GENCTRL.reg = 0x2         // GCLK#2
+        | (0x3 << 8u)               // Source=3(OSCULP32K)
+        | (0x1 << 16u)              // Enable
+        | (0x1 << 21u)              // Run in standby
+        ;
+    while(GCLK->STATUS.reg & (1 << 7u));
+
+    current_clock = CPU_CLOCK_8MHZ;
+}
+
+UINT32 set_cpu_clock(cpu_clock clock){
+    UINT32 start = timebase_now();
+    UINT32 coarse;
+
+    if(clock == current_clock)  return 0;
+
+    if(clock == CPU_CLOCK_48MHZ){
+            // Errata: the DFLL must be enabled with ONDEMAND cleared
+            //  before any other DFLL register is written
+        SYSCTRL->DFLLCTRL.reg = 0x1u << 1;  // Enable, open loop
+        while(!(SYSCTRL->PCLKSR.reg & (1 << 4u)));  // Wait for DFLLRDY
+
+        coarse = (*((uint32_t*)NVMCTRL_OTP4 + NVM_DFLL_COARSE_POS/32)
+            >> (NVM_DFLL_COARSE_POS % 32)) & ((1u << NVM_DFLL_COARSE_SIZE) - 1);
+        SYSCTRL->DFLLVAL.reg = (coarse << 10u) | 512u; // Fine at mid range
+        while(!(SYSCTRL->PCLKSR.reg & (1 << 4u)));
+
+            // One wait state is needed above 24 MHz; add it before the
+            //  clock goes up
+        system_flash_set_waitstates(1);
+        GCLK->GENCTRL.reg = 0x030700;       // GCLK#0 enable, Source=7(DFLL48M), IDC=1
+        while(GCLK->STATUS.reg & (1 << 7u));
+    }
+    else{
+        GCLK->GENCTRL.reg = 0x030600;       // GCLK#0 enable, Source=6(OSC8M), IDC=1
+        while(GCLK->STATUS.reg & (1 << 7u));
+            // Fewer wait states only once the clock is down
+        system_flash_set_waitstates(0);
+        SYSCTRL->DFLLCTRL.reg = 0;          // Stop the DFLL
+    }
+    current_clock = clock;
+
+    return timebase_elapsed(start);
+}
+
+cpu_clock get_cpu_clock(void){
+    return current_clock;
+}
+
+UINT32 cpu_clock_hz(void){
+    return current_clock == CPU_CLOCK_48MHZ ? 48000000u : 8000000u;
 }
\ No newline at end of file
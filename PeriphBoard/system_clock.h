@@ -1,6 +1,30 @@
 #ifndef SYSTEMM_CLOCK_INITIALIZATION_THAT_IS_SIMPLE283947823_HHHHHH___
 #define SYSTEMM_CLOCK_INITIALIZATION_THAT_IS_SIMPLE283947823_HHHHHH___
 
+#include "extended_types.h"
+
+    // Generic clock generator for every peripheral (TCs, ADC, DAC).
+    //  It stays on OSC8M at 8 MHz whatever the CPU runs at, so sample and
+    //  display timing never change with the CPU clock.
+#define PERIPH_GCLK     1
+#define PERIPH_GCLK_HZ  8000000u
+    // Slow generic clock generator from OSCULP32K, running in standby,
+    //  for the RTC and the watchdog
+#define SLOW_GCLK       2
+#define SLOW_GCLK_HZ    1024u
+
+typedef enum{
+    CPU_CLOCK_8MHZ = 0,     // GCLK0 from OSC8M, no flash wait state
+    CPU_CLOCK_48MHZ         // GCLK0 from DFLL48M (open loop), 1 wait state
+} cpu_clock;
+
 void Simple_Clk_Init(void);
+    // Switch GCLK0 and with it the CPU, returns the time taken in
+    //  microseconds. Call only after configure_timebase().
+    //  SysTick counts CPU cycles, so cycle counts taken across a switch
+    //  mix both rates.
+UINT32 set_cpu_clock(cpu_clock clock);
+cpu_clock get_cpu_clock(void);
+UINT32 cpu_clock_hz(void);
 
 #endif
\ No newline at end of file
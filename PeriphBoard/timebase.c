@@ -0,0 +1,50 @@
+#include "timebase.h"
+
+#include <asf.h>
+#include "global_ports.h"
+#include "system_clock.h"
+
+void configure_timebase(void){
+    PM->APBCMASK.reg |= (1 << 12u) | (1 << 13u);  // TC4 and TC5 (see pg 129)
+
+    uint32_t temp=0x15;   // ID for TC4 and TC5 is 0x15  (see table 14-2)
+    temp |= PERIPH_GCLK<<8;    //  Selection of the fixed peripheral clock generator
+    GCLK->CLKCTRL.reg=temp;   //  Setup in the CLKCTRL register
+    GCLK->CLKCTRL.reg |= 0x1u << 14;    // enable it.
+
+    timer4_32->CTRLA.reg &= ~(1 << 1u);    // Disable the timer
+    while(timer4_32->STATUS.reg & (1 << 7u));    // Synchronize before proceeding
+
+    timer4_32->CTRLA.reg =
+          (0x1 << 12u)  // Set presynchronizer to prescaled clock
+        | (0x3 << 8u)   // Prescale PERIPH_GCLK (8 MHz) by 8
+        | (0x2 << 2u)   // 32-bit mode, TC5 becomes the upper half
+        ;               // Normal frequency, count up through 2^32
+    timer4_32->COUNT.reg = 0;
+    while(timer4_32->STATUS.reg & (1 << 7u));
+
+        // Keep COUNT synchronized so reads need no request and wait
+    timer4_32->READREQ.reg =
+          (0x1 << 14u)  // Continuous read synchronization
+        | 0x10          // of the COUNT register offset
+        ;
+
+    timer4_32->CTRLA.reg |= 1 << 1u;    // Start counting
+    while(timer4_32->STATUS.reg & (1 << 7u));
+}
+
+RAMFUNC UINT32 timebase_now(void){
+    return timer4_32->COUNT.reg;
+}
+
+RAMFUNC UINT32 timebase_elapsed(UINT32 start){
+    return timer4_32->COUNT.reg - start;
+}
+
+RAMFUNC UINT32 timebase_deadline(UINT32 us){
+    return timer4_32->COUNT.reg + us;
+}
+
+RAMFUNC BOOLEAN__ deadline_passed(UINT32 deadline){
+    return (INT32)(timer4_32->COUNT.reg - deadline) >= 0;
+}
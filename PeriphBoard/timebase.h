@@ -0,0 +1,27 @@
+#ifndef MICROSECOND_TIMEBASE_HDR5530817______
+#define MICROSECOND_TIMEBASE_HDR5530817______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+    // Free running 1 MHz timebase on TC4 and TC5 chained as one 32-bit
+    //  counter, wrapping every 71.6 minutes. It runs from PERIPH_GCLK, so
+    //  it keeps time across CPU clock changes. Nothing ever waits on it:
+    //  code takes a timestamp or sets a deadline and checks back later,
+    //  typically from a timer_wheel callback or the main loop.
+    //  All arithmetic is modulo 2^32, so intervals below the wrap
+    //  period are measured correctly across a wrap; deadlines may be
+    //  at most 2^31 us (35 minutes) ahead.
+    //  Call configure_global_ports() first.
+
+#define TIMEBASE_HZ     1000000u
+
+void configure_timebase(void);
+RAMFUNC UINT32 timebase_now(void);
+    // Microseconds since start, a timestamp from timebase_now()
+RAMFUNC UINT32 timebase_elapsed(UINT32 start);
+    // Timestamp us microseconds from now, to be checked with deadline_passed()
+RAMFUNC UINT32 timebase_deadline(UINT32 us);
+RAMFUNC BOOLEAN__ deadline_passed(UINT32 deadline);
+
+#endif
@@ -0,0 +1,92 @@
+#include "timer_wheel.h"
+
+#include <asf.h>
+
+static sw_timer* wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static volatile UINT32 now;
+
+static RAMFUNC void link_timer(sw_timer* timer){
+    UINT32 delta = timer->expires - now;
+    sw_timer** slot;
+
+    if(delta < WHEEL_SLOTS)
+        slot = &wheel[0][timer->expires & WHEEL_MASK];
+    else if(delta < WHEEL_SLOTS*WHEEL_SLOTS)
+        slot = &wheel[1][(timer->expires >> WHEEL_BITS) & WHEEL_MASK];
+    else    // Beyond the wheel, re-filed once this slot cascades
+        slot = &wheel[1][((now + WHEEL_SLOTS*WHEEL_SLOTS - 1) >> WHEEL_BITS) & WHEEL_MASK];
+
+    timer->next = *slot;
+    if(!IS_NULL(timer->next)) timer->next->pprev = &timer->next;
+    timer->pprev = slot;
+    *slot = timer;
+}
+
+static RAMFUNC void unlink_timer(sw_timer* timer){
+    *timer->pprev = timer->next;
+    if(!IS_NULL(timer->next)) timer->next->pprev = timer->pprev;
+    timer->pprev = NULL;
+}
+
+void configure_timer_wheel(void){
+    UINT8 level, slot;
+    for(level = 0; level < WHEEL_LEVELS; ++level)
+        for(slot = 0; slot < WHEEL_SLOTS; ++slot)
+            wheel[level][slot] = NULL;
+    now = 0;
+}
+
+void timer_start(sw_timer* timer, UINT32 delay, UINT32 period, sw_timer_callback callback){
+    UINT32 primask = __get_PRIMASK();
+    __disable_irq();
+    if(!IS_NULL(timer->pprev)) unlink_timer(timer);
+        // The slot for the current tick has already been processed
+    timer->expires = now + (delay ? delay : 1);
+    timer->period = period;
+    timer->callback = callback;
+    link_timer(timer);
+    __set_PRIMASK(primask);
+}
+
+void timer_cancel(sw_timer* timer){
+    UINT32 primask = __get_PRIMASK();
+    __disable_irq();
+    if(!IS_NULL(timer->pprev)) unlink_timer(timer);
+    __set_PRIMASK(primask);
+}
+
+BOOLEAN__ timer_pending(const sw_timer* timer){
+    return !IS_NULL(timer->pprev);
+}
+
+RAMFUNC void timer_wheel_tick(void){
+    sw_timer* timer;
+    sw_timer* next;
+
+    ++now;
+        // Level 0 wrapped, move the next block of level 1 down
+    if(!(now & WHEEL_MASK)){
+        timer = wheel[1][(now >> WHEEL_BITS) & WHEEL_MASK];
+        wheel[1][(now >> WHEEL_BITS) & WHEEL_MASK] = NULL;
+        for(; !IS_NULL(timer); timer = next){
+            next = timer->next;
+            link_timer(timer);
+        }
+    }
+
+    for(;;){
+        timer = wheel[0][now & WHEEL_MASK];
+        if(IS_NULL(timer)) break;
+        unlink_timer(timer);
+            // Re-arm before the call so the callback may cancel or restart
+        if(timer->period){
+            timer->expires += timer->period;
+            link_timer(timer);
+        }
+        timer->callback(timer);
+    }
+}
+
+UINT32 timer_wheel_now(void){
+    return now;
+}
@@ -0,0 +1,43 @@
+#ifndef TIMER_WHEEL_HDR4471902______
+#define TIMER_WHEEL_HDR4471902______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+    // Hierarchical timer wheel: any number of software timers share one
+    //  hardware tick. Level 0 holds timers due within WHEEL_SLOTS ticks,
+    //  level 1 those due within WHEEL_SLOTS^2 ticks; a level 1 slot is
+    //  moved down to level 0 each time level 0 wraps. Start, cancel and
+    //  expiry are O(1) per timer. Longer delays are parked in the last
+    //  level 1 slot and re-filed when it cascades.
+    //
+    //  Callbacks run from timer_wheel_tick(), so in interrupt context.
+    //  A sw_timer must start zeroed, as it does in static storage.
+
+#define WHEEL_BITS      6
+#define WHEEL_SLOTS     (1u << WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS    2
+
+typedef struct sw_timer sw_timer;
+typedef void (*sw_timer_callback)(sw_timer* timer);
+
+struct sw_timer{
+    sw_timer* next;
+    sw_timer** pprev;       // NULL while the timer is not pending
+    UINT32 expires;         // Tick at which the callback runs
+    UINT32 period;          // Ticks between runs, 0 for one-shot
+    sw_timer_callback callback;
+};
+
+void configure_timer_wheel(void);
+    // Run callback after delay ticks (at least one), then every period
+    //  ticks if period is non-zero. Restarts a pending timer.
+void timer_start(sw_timer* timer, UINT32 delay, UINT32 period, sw_timer_callback callback);
+void timer_cancel(sw_timer* timer);
+BOOLEAN__ timer_pending(const sw_timer* timer);
+    // Advance the wheel by one tick, call from the tick interrupt
+RAMFUNC void timer_wheel_tick(void);
+UINT32 timer_wheel_now(void);
+
+#endif
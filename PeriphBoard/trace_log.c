@@ -0,0 +1,22 @@
+#include "trace_log.h"
+
+#include "cycle_counter.h"
+
+trace_log trace_buffer;
+
+void configure_trace_log(void){
+    configure_cycle_counter();
+    trace_buffer.head = 0;
+    trace_buffer.magic = TRACE_MAGIC;
+}
+
+RAMFUNC void trace_event(trace_id id, UINT32 value){
+        // Interrupts off so a nested handler cannot take the same slot
+    UINT32 primask = __get_PRIMASK();
+    UINT32 slot;
+    __disable_irq();
+    slot = trace_buffer.head++ & (TRACE_SIZE - 1);
+    trace_buffer.entry[slot][0] = ((UINT32)id << 24) | CYCLES_NOW();
+    trace_buffer.entry[slot][1] = value;
+    __set_PRIMASK(primask);
+}
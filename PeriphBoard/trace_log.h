@@ -0,0 +1,47 @@
+#ifndef EVENT_TRACE_LOG_HDR8812034______
+#define EVENT_TRACE_LOG_HDR8812034______
+
+#include "extended_types.h"
+#include "ram_placement.h"
+
+// Uncomment the below macro to record timestamped interrupt, ADC, DAC
+//  and port events into trace_buffer. Dump trace_buffer with the
+//  debugger and convert it with tools/trace2vcd.py.
+//#define TRACE_LOG
+
+    // Must be a power of 2
+#define TRACE_SIZE  256
+#define TRACE_MAGIC 0x54524345u     // "TRCE"
+
+typedef enum{
+    TRACE_TC6_ENTER = 1,
+    TRACE_TC6_EXIT,
+    TRACE_TC7_ENTER,
+    TRACE_TC7_EXIT,
+    TRACE_ADC,          // Raw conversion result
+    TRACE_DAC,          // Value written to the DAC
+    TRACE_PORTA,        // Snapshot of PORT A OUT
+    TRACE_PORTB         // Snapshot of PORT B OUT
+} trace_id;
+
+    // Each entry is two words: (id << 24 | 24-bit cycle stamp), value.
+    //  The stamp is the free-running SysTick count, which the converter
+    //  unwraps. Events must therefore be less than 2^24 cycles apart.
+typedef struct{
+    UINT32 magic;
+    UINT32 head;        // Total events written; the ring holds the last TRACE_SIZE
+    UINT32 entry[TRACE_SIZE][2];
+} trace_log;
+
+extern trace_log trace_buffer;
+
+#ifdef TRACE_LOG
+    #define TRACE(ID, VAL)  trace_event((ID), (VAL))
+#else
+    #define TRACE(ID, VAL)
+#endif
+
+void configure_trace_log(void);
+RAMFUNC void trace_event(trace_id id, UINT32 value);
+
+#endif
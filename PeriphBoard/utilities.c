@@ -9,7 +9,7 @@ UINT32 find_lsob(UINT32 target){
     return toreturn;
 }
 
-UINT32 map32(
+RAMFUNC UINT32 map32(
     UINT32 orig,
     UINT32 old_min, UINT32 old_max,
     UINT32 new_min, UINT32 new_max
@@ -18,11 +18,18 @@ UINT32 map32(
     return ((orig-old_min)*(new_max-new_min))/(old_max-new_min) + new_min;
 }
 
-float mapf(
+RAMFUNC float mapf(
     float orig,
     float old_min, float old_max,
     float new_min, float new_max
     )
 {
     return ((orig-old_min)*(new_max-new_min))/(old_max-new_min) + new_min;
+}
+
+#define FNV1A_PRIME 16777619u
+
+RAMFUNC UINT32 fnv1a16(UINT32 hash, UINT16 val){
+    hash = (hash ^ (val & 0xFF))*FNV1A_PRIME;
+    return (hash ^ (val >> 8))*FNV1A_PRIME;
 }
\ No newline at end of file
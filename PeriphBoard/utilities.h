@@ -2,17 +2,22 @@
 #define UTILITYES_HDR238838777______7477______
 
 #include "extended_types.h"
+#include "ram_placement.h"
 
 UINT32 find_lsob(UINT32 target);    // Find least significant ON bit
-UINT32 map32(
+RAMFUNC UINT32 map32(
     UINT32 orig,
     UINT32 old_min, UINT32 old_max,
     UINT32 new_min, UINT32 new_max
     );
-float mapf(
+RAMFUNC float mapf(
     float orig,
     float old_min, float old_max,
     float new_min, float new_max
     );
+    // One step of a 32-bit FNV-1a hash over a 16-bit value.
+    //  Start a hash at FNV1A_INIT.
+#define FNV1A_INIT 2166136261u
+RAMFUNC UINT32 fnv1a16(UINT32 hash, UINT16 val);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "watchdog.h"
+
+#include <asf.h>
+#include "system_clock.h"
+#include "crash_log.h"
+
+volatile UINT8 heartbeats[HEARTBEAT_COUNT];
+volatile watchdog_context watchdog_warning;
+
+static UINT8 expected_beats;
+static volatile UINT32 last_overruns;
+
+static void clear_heartbeats(void){
+    UINT8 i;
+    for(i = 0; i < HEARTBEAT_COUNT; ++i)    heartbeats[i] = 0;
+}
+
+static UINT8 missing_heartbeats(void){
+    UINT8 missing = 0, i;
+    for(i = 0; i < HEARTBEAT_COUNT; ++i)
+        if(!heartbeats[i])  missing |= HEARTBEAT_BIT(i);
+    return missing & expected_beats;
+}
+
+void configure_watchdog(UINT8 expected){
+    PM->APBAMASK.reg |= 1u << 4;    // WDT clock (page 127)
+
+    GCLK->CLKCTRL.reg = 0x03        // ID for WDT is 0x03  (see table 14-2)
+        | (SLOW_GCLK << 8u)         // Slow generic clock generator
+        | (0x1u << 14);             // enable it.
+
+    WDT->CTRL.reg = 0;              // Disable before configuring
+    while(WDT->STATUS.reg & (1 << 7u));
+    WDT->CONFIG.reg = 0x9;          // Reset after 4096 cycles
+    WDT->EWCTRL.reg = 0x8;          // Early warning after 2048 cycles
+    while(WDT->STATUS.reg & (1 << 7u));
+
+    WDT->INTFLAG.reg = 0x1;
+    WDT->INTENSET.reg = 0x1;        // Early warning interrupt
+    NVIC_SetPriority(WDT_IRQn, 0);  // Above TC6 and TC7
+    NVIC->ISER[0] |= 1 << 2u;       // WDT is interrupt 2
+
+    expected_beats = expected;
+    last_overruns = 0;
+    clear_heartbeats();
+
+    WDT->CTRL.reg = 1 << 1u;        // Enable
+    while(WDT->STATUS.reg & (1 << 7u));
+}
+
+void watchdog_expect(UINT8 expected){
+    expected_beats = expected;
+}
+
+BOOLEAN__ watchdog_check(UINT32 overruns){
+    last_overruns = overruns;
+    if(missing_heartbeats())    return FALSE__;
+
+    clear_heartbeats();
+    while(WDT->STATUS.reg & (1 << 7u));
+    WDT->CLEAR.reg = 0xA5;          // Feed
+    return TRUE__;
+}
+
+    // Called from WDT_Handler with the exception stack frame
+void watchdog_early_warning(UINT32* frame){
+    WDT->INTFLAG.reg = 0x1;         // Write one to clear only this flag
+    watchdog_warning.missing = missing_heartbeats();
+    watchdog_warning.overruns = last_overruns;
+    watchdog_warning.lr = frame[5];
+    watchdog_warning.pc = frame[6];
+    ++watchdog_warning.count;
+
+#ifdef CRASH_LOG
+        // The reset is two seconds away, keep the evidence
+    crash_log_event(CRASH_EV_WDT_WARNING, watchdog_warning.missing);
+    crash_log_overruns(last_overruns);
+    crash_log_seal(CRASH_CAUSE_WATCHDOG, frame);
+#endif
+}
+
+STACKED_FRAME_HANDLER(WDT_Handler, watchdog_early_warning)
@@ -0,0 +1,61 @@
+#ifndef WATCHDOG_SUPERVISOR_HDR6602583______
+#define WATCHDOG_SUPERVISOR_HDR6602583______
+
+#include "extended_types.h"
+
+    // Watchdog fed only while every expected context shows signs of
+    //  life. Each context marks its heartbeat with HEARTBEAT(), a single
+    //  byte store, and watchdog_check() (called periodically, e.g. from a
+    //  timer_wheel callback or after a wake from standby) feeds the WDT
+    //  and clears the marks only when all expected heartbeats are
+    //  present. A hung context therefore resets the device
+    //  WDT_TIMEOUT_MS after its last heartbeat at most.
+    //
+    //  Sample overruns alone never cause a reset: a loaded but live system
+    //  keeps beating. The early-warning interrupt fires WDT_WARNING_MS
+    //  before the reset and records the missing heartbeats, the overrun
+    //  count and where the CPU was in watchdog_warning, and, with
+    //  CRASH_LOG, seals the crash log (crash_log.h) so the record survives
+    //  the reset.
+    //
+    //  The WDT runs from SLOW_GCLK, also in standby. The warning comes
+    //  late enough to sleep through a whole BURST_PERIOD_MS between two
+    //  checks. It has the highest interrupt priority, the sampling and
+    //  display interrupts run one level below, so it also preempts a
+    //  handler that hangs.
+
+#define WDT_TIMEOUT_MS  4000    // 4096 cycles of SLOW_GCLK
+#define WDT_WARNING_MS  2000    // Early warning 2048 cycles in
+
+typedef enum{
+    HEARTBEAT_SAMPLING = 0, // TC6 interrupt
+    HEARTBEAT_DISPLAY,      // TC7 interrupt
+    HEARTBEAT_MAIN,         // Main loop
+    HEARTBEAT_COUNT
+} heartbeat_id;
+
+#define HEARTBEAT_BIT(H)    (1u << (H))
+#define HEARTBEAT_ALL       (HEARTBEAT_BIT(HEARTBEAT_COUNT) - 1)
+
+extern volatile UINT8 heartbeats[HEARTBEAT_COUNT];
+    // Each heartbeat has a single writer, so no read-modify-write is needed
+#define HEARTBEAT(H)        (heartbeats[H] = 1)
+
+typedef struct{
+    UINT32 count;           // Early warnings so far, 0 if none
+    UINT8 missing;          // Expected heartbeats absent at the warning
+    UINT32 overruns;        // Sample overruns at the warning
+    UINT32 pc;              // Return address of the interrupted code
+    UINT32 lr;
+} watchdog_context;
+
+extern volatile watchdog_context watchdog_warning;
+
+void configure_watchdog(UINT8 expected);
+    // Change which heartbeats are required, e.g. when sampling stops
+void watchdog_expect(UINT8 expected);
+    // Feed if all expected heartbeats arrived since the last feed.
+    //  overruns is the current sample overrun total, kept for the report.
+BOOLEAN__ watchdog_check(UINT32 overruns);
+
+#endif
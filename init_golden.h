@@ -0,0 +1,52 @@
+#ifndef INIT_GOLDEN_IMAGE_HDR2209381______
+#define INIT_GOLDEN_IMAGE_HDR2209381______
+
+#include "PeriphBoard/init_check.h"
+
+    // Final register image expected after main() has run every init
+    //  routine (configure_adc, configure_dac_default, configure_ssd_ports,
+    //  configure_adc_interrupt, configure_display_interrupt).
+    // Any change to an init path must leave these unchanged unless the
+    //  entry is updated in the same commit. The order of the writes is
+    //  not checked, so init code is free to be reordered.
+static const golden_reg init_golden[] = {
+        // ADC, see configure_adc() call in main()
+    GOLDEN_REG(ADC->CTRLA.reg,      0x02,       0x02),
+    GOLDEN_REG(ADC->REFCTRL.reg,    0x8F,       0x02),
+#if RESOLUTION == 16
+    GOLDEN_REG(ADC->AVGCTRL.reg,    0x7F,       0x08),
+    GOLDEN_REG(ADC->CTRLB.reg,      0x073F,     0x0110),
+#elif RESOLUTION == 12
+    GOLDEN_REG(ADC->AVGCTRL.reg,    0x7F,       0x00),
+    GOLDEN_REG(ADC->CTRLB.reg,      0x073F,     0x0100),
+#endif
+    GOLDEN_REG(ADC->SAMPCTRL.reg,   0x3F,       0x00),
+    GOLDEN_REG(ADC->INPUTCTRL.reg,  0x0FFF1F1F, 0x0F001813),
+        // DAC, see configure_dac_default()
+    GOLDEN_REG(DAC->CTRLA.reg,      0x02,       0x02),
+    GOLDEN_REG(DAC->CTRLB.reg,      0xDF,       0x41),
+        // TC6 sampling timer, see configure_adc_interrupt()
+    GOLDEN_REG(TC6->COUNT8.CTRLA.reg,    0x3F6E,    0x1546),
+    GOLDEN_REG(TC6->COUNT8.PER.reg,      0xFF,      124),
+    GOLDEN_REG(TC6->COUNT8.INTENSET.reg, 0x3B,      0x01),
+        // TC7 display timer, see configure_display_interrupt()
+    GOLDEN_REG(TC7->COUNT16.CTRLA.reg,   0x3F6E,    0x1322),
+    GOLDEN_REG(TC7->COUNT16.CC[0].reg,   0xFFFF,    999),
+    GOLDEN_REG(TC7->COUNT16.INTENSET.reg, 0x3B,     0x01),
+        // TC4/TC5 microsecond timebase, see configure_timebase()
+    GOLDEN_REG(TC4->COUNT32.CTRLA.reg,   0x3F6E,    0x130A),
+        // Clocks for TC4, TC5, TC6, TC7, ADC and DAC
+    GOLDEN_REG(PM->APBCMASK.reg, 0x0005F000, 0x0005F000),
+        // Port directions: SSD power, segments, sign and trace pins
+    GOLDEN_REG(PORT->Group[0].DIR.reg, 0x000000F0, 0x000000F0),
+    GOLDEN_REG(PORT->Group[1].DIR.reg, 0x000302FF, 0x000302FF),
+        // Analog pins: ADC on PA11, DAC on PA02 (function B)
+    GOLDEN_REG(PORT->Group[0].PINCFG[11].reg, 0x01, 0x01),
+    GOLDEN_REG(PORT->Group[0].PMUX[5].reg,    0xF0, 0x10),
+    GOLDEN_REG(PORT->Group[0].PINCFG[2].reg,  0x41, 0x41),
+    GOLDEN_REG(PORT->Group[0].PMUX[1].reg,    0x0F, 0x01),
+};
+
+#define INIT_GOLDEN_SIZE (sizeof(init_golden)/sizeof(init_golden[0]))
+
+#endif
@@ -5,12 +5,84 @@
 #include "PeriphBoard/ssd.h"
 #include "PeriphBoard/adc_dac.h"
 #include "PeriphBoard/utilities.h"
+#include "PeriphBoard/cycle_counter.h"
+#include "PeriphBoard/filters.h"
+#include "PeriphBoard/bfp_filter.h"
+#include "PeriphBoard/ram_placement.h"
+#include "PeriphBoard/stack_monitor.h"
+#include "PeriphBoard/fault_inject.h"
+#include "PeriphBoard/trace_log.h"
+#include "PeriphBoard/event_bus.h"
+#include "PeriphBoard/timer_wheel.h"
+#include "PeriphBoard/timebase.h"
+#include "PeriphBoard/keypad.h"
+#include "PeriphBoard/pt.h"
+#include "PeriphBoard/clock_governor.h"
+#include "PeriphBoard/power_gate.h"
+#include "PeriphBoard/rtc_wake.h"
+#include "PeriphBoard/watchdog.h"
+#include "PeriphBoard/crash_log.h"
 
     // Switch between using 16-bit and 12-bit resolution for the ADC
 #define RESOLUTION 12
     // Switch betwen LPF and notch filter
     // Comment out to switch to Notch
 #define FILTER_LPF
+    // Run the notch in block floating point (16x16->32 multiplies only)
+    //  instead of soft float. Has no effect on the LPF.
+//#define NOTCH_BFP
+    // Write the previous sample's output to the DAC on ISR entry, before
+    //  filtering the next sample. The output instant then no longer
+    //  depends on the soft-float filter time, at the cost of one sample
+    //  period of fixed latency.
+    // Comment out to write the DAC as soon as each output is computed.
+#define DAC_PIPELINED
+    // Record the period between DAC writes (in CPU cycles) in dac_period.
+    //  Output jitter is dac_period.max - dac_period.min.
+//#define MEASURE_DAC_JITTER
+    // Record the CPU cycles spent in the filter for each sample
+    //  in filter_cycles.
+//#define MEASURE_FILTER_CYCLES
+    // Record the CPU cycles spent in each TC6 interrupt in isr_cycles.
+    //  Use to compare flash and SRAM placement (see ram_placement.h).
+//#define MEASURE_ISR_CYCLES
+    // Record the CPU cycles of each keypad_task() call, including the
+    //  protothread resume, in task_cycles.
+//#define MEASURE_TASK_CYCLES
+    // Paint the main stack at startup so main_stack_high_water() can
+    //  report the deepest stack use, interrupts included.
+#define MONITOR_STACK
+    // After initialization, compare the peripheral registers against the
+    //  golden image in init_golden.h. A mismatch shows E and the index
+    //  of the first bad entry on the display.
+//#define CHECK_INIT_GOLDEN
+    // Corrupt the acquisition path as configured in fault_setup below
+    //  to see how filtering and overrun handling degrade.
+//#define FAULT_INJECTION
+    // Replace each ADC result with the next entry of the flash table in
+    //  replay_samples.h (12-bit codes), so every run sees identical input.
+    //  The conversion itself still runs to keep the ISR timing unchanged.
+    //  replay_checksum becomes the FNV-1a hash of the DAC codes computed
+    //  over the first pass through the table; compare it with
+    //  tools/replay_check.c built for the same filter.
+//#define REPLAY_INPUT
+    // Run the CPU from OSC8M at 8 MHz while the sampling interrupt load is
+    //  light and from DFLL48M at 48 MHz while it is heavy (see
+    //  clock_governor.h). Peripherals stay on a fixed 8 MHz clock.
+    //  The MEASURE_* statistics and TRACE_LOG stamps count SysTick cycles
+    //  at a single CPU clock, so they cannot be combined with this.
+//#define CLOCK_SCALING
+    // Sample in bursts of BURST_SIZE at the full rate, one burst every
+    //  BURST_PERIOD_MS, with the peripherals gated and the device in
+    //  standby in between. Filter state carries over from burst to burst.
+    //  The display is only lit during a burst.
+//#define BURST_MODE
+    // Reset through the WDT when the sampling interrupt, the display
+    //  interrupt or the main loop stops making progress (see watchdog.h).
+    //  Comment out while stepping through code with a debugger.
+#define WATCHDOG
+    // CRASH_LOG, the post-mortem log in NOINIT RAM, is switched in
+    //  crash_log.h, since the HardFault and WDT handlers also depend on it.
 
 void enable_adc_tc_clocks(void);
 void enable_adc_timer(void);
@@ -19,7 +91,9 @@ void disable_adc_timer(void);
     //  remain disabled after configuration.
 void configure_adc_interrupt(void);
 
-void adc_handler(void);
+RAMFUNC void adc_handler(void);
+RAMFUNC void process_sample(UINT32 adc_raw);
+RAMFUNC void output_to_dac(UINT16 val);
 
 void enable_display_tc_clocks(void);
 void enable_display_timer(void);
@@ -28,7 +102,14 @@ void disable_display_timer(void);
     //  remain disabled after configuration.
 void configure_display_interrupt(void);
 
-void display_handler(void);
+void display_handler(sw_timer* timer);
+
+void show_overrun(event_type type, UINT32 data);
+void roll_up_stats(sw_timer* timer);
+void take_keypress(event_type type, UINT32 data);
+void scale_clock(sw_timer* timer);
+void supervise(sw_timer* timer);
+PT_THREAD(display_task(pt* thread));
 
 static TcCount16* disp_timer;
 static TcCount8* adc_timer;
@@ -37,23 +118,150 @@ static TcCount8* adc_timer;
 #define AIN_PIN     0x13    // Use 0x13 as the port map to the analog pin
 #define DAC_PIN     2       // Use pin 2 to output waveform
 
-#define PI 3.14
-
 #if RESOLUTION == 16
     #define RES_MAX 0xFFFF
 #elif RESOLUTION == 12
     #define RES_MAX 4095
 #endif
 
+#define TICK_HZ     1000    // TC7 drives the software timer wheel
+
 #define DISPLAY_DIGIT_SIZE_MAX 4
 static UINT8 display_number[DISPLAY_DIGIT_SIZE_MAX] = {1, 1, 1, 1};
+#define DISPLAY_UPDATE_US   100000  // Reformat the reading at 10 Hz
+#define KEY_SHOW_US         1000000 // Show a pressed key for a second
+
+    // Latest input in millivolts, formatted for the display by display_task
+static volatile UINT32 display_mv = 0;
+static volatile UINT8 pressed_key = 0;
+static volatile BOOLEAN__ key_pending = FALSE__;
+
+static keypad_task_state keypad;
+static pt display_thread;
+
+#ifdef BURST_MODE
+#define BURST_SIZE          64
+#define BURST_PERIOD_MS     1000
+    // Samples left in the current burst, 0 between bursts
+static volatile UINT16 burst_remaining = BURST_SIZE;
+static volatile UINT16 burst_output = 0;
+#endif
+
+    // Sampling periods that elapsed while a sample was still processed
+static volatile UINT32 sample_overruns = 0;
+    // Sampling periods whose ADC conversion had not finished, skipped
+static volatile UINT32 adc_misses = 0;
+    // DAC writes dropped because the previous one was still synchronizing
+static volatile UINT32 dac_skips = 0;
+    // Lights the decimal point of the first digit once an overrun occurred
+static volatile BOOLEAN__ overrun_indicator = FALSE__;
+    // Overruns counted over the last whole second
+static volatile UINT32 overruns_per_second = 0;
+
+    // Periodic activities multiplexed onto the TC7 tick
+static sw_timer display_refresh;
+static sw_timer stats_rollup;
+#ifdef CLOCK_SCALING
+#define GOVERNOR_WINDOW_MS  100
+static sw_timer clock_scaling;
+    #if defined(MEASURE_DAC_JITTER) || defined(MEASURE_FILTER_CYCLES) \
+        || defined(MEASURE_ISR_CYCLES) || defined(MEASURE_TASK_CYCLES) \
+        || defined(TRACE_LOG)
+        #error "Cycle counts would mix 8 MHz and 48 MHz cycles"
+    #endif
+#endif
+#ifdef WATCHDOG
+#define WDT_CHECK_MS        250
+static sw_timer supervision;
+        // TC7 stops in standby, so the wheel check only sees the time spent
+        //  in bursts. The main loop checks after each RTC wake instead,
+        //  which must come before the early warning.
+    #if defined(BURST_MODE) \
+        && BURST_PERIOD_MS + BURST_SIZE*1000/SAMP_FREQ >= WDT_WARNING_MS
+        #error "The watchdog would warn while in standby between bursts"
+    #endif
+#endif
+
+#ifdef FAULT_INJECTION
+static const fault_config fault_setup = {
+    0x1234567u, // Seed
+    8,          // +-8 LSB noise
+    0x0000,     // No bits stuck high
+    0x0001,     // LSB stuck low
+    655,        // Flip a bit in about 1% of samples
+    0,          // RESRDY on time
+    328,        // Drop about 0.5% of interrupts
+    328,        // Handle about 0.5% of interrupts twice
+    0,          // No DAC stall
+};
+#endif
+
+#ifdef REPLAY_INPUT
+    #include "replay_samples.h"
+    // 0 until the first pass through the table has finished
+static volatile UINT32 replay_checksum = 0;
+#endif
+
+#ifdef CHECK_INIT_GOLDEN
+    // Needs RESOLUTION
+    #include "init_golden.h"
+static UINT8 init_mismatches = 0;
+#endif
+
+#ifdef MEASURE_DAC_JITTER
+static cycle_stats dac_period;
+#endif
+#ifdef MEASURE_FILTER_CYCLES
+static cycle_stats filter_cycles;
+#endif
+#ifdef MEASURE_ISR_CYCLES
+static cycle_stats isr_cycles;
+#endif
+#ifdef MEASURE_TASK_CYCLES
+static cycle_stats task_cycles;
+#endif
 
 int main (void)
 {
+    BOOLEAN__ show_readings = TRUE__;
+#ifdef MONITOR_STACK
+    paint_main_stack();
+#endif
+#ifdef FAULT_INJECTION
+    configure_faults(&fault_setup);
+#endif
+#ifdef TRACE_LOG
+    configure_trace_log();
+#endif
+    configure_event_bus();
+    event_subscribe(EVENT_OVERRUN, show_overrun);
+    event_subscribe(EVENT_KEYPRESS, take_keypress);
     Simple_Clk_Init();
-    delay_init();
+#if defined(MEASURE_DAC_JITTER) || defined(MEASURE_FILTER_CYCLES) \
+    || defined(MEASURE_ISR_CYCLES) || defined(MEASURE_TASK_CYCLES)
+    configure_cycle_counter();
+#endif
+#ifdef MEASURE_DAC_JITTER
+    reset_cycle_stats(&dac_period);
+#endif
+#ifdef MEASURE_FILTER_CYCLES
+    reset_cycle_stats(&filter_cycles);
+#endif
+#ifdef MEASURE_ISR_CYCLES
+    reset_cycle_stats(&isr_cycles);
+#endif
+#ifdef MEASURE_TASK_CYCLES
+    reset_cycle_stats(&task_cycles);
+#endif
     configure_global_ports();
+    configure_timebase();
+#ifdef CRASH_LOG
+    crash_log_boot();
+#endif
     configure_ssd_ports();
+    configure_keypad_ports();
+    configure_keypad_task(&keypad);
+    PT_INIT(&display_thread);
 
     bankB->DIR.reg |= (1 << 16u) | (1 << 17u);
 
@@ -95,12 +303,101 @@ int main (void)
     configure_dac_default();
 
     configure_adc_interrupt();
+    start_adc();    // The first interrupt takes this result
     enable_adc_timer();
 
+    configure_timer_wheel();
+    timer_start(&display_refresh, 1, 1, display_handler);
+    timer_start(&stats_rollup, TICK_HZ, TICK_HZ, roll_up_stats);
+#ifdef CLOCK_SCALING
+    configure_clock_governor();
+    timer_start(&clock_scaling, GOVERNOR_WINDOW_MS, GOVERNOR_WINDOW_MS, scale_clock);
+#endif
     configure_display_interrupt();
     enable_display_timer();
 
-    return 0;
+#ifdef CHECK_INIT_GOLDEN
+    {
+        UINT8 first_bad = 0;
+        init_mismatches = check_golden_regs(init_golden, INIT_GOLDEN_SIZE, &first_bad);
+        if(init_mismatches){
+                // The ADC interrupt and display task would overwrite the
+                //  error code
+            disable_adc_timer();
+            show_readings = FALSE__;
+            display_number[0] = 0xE;
+            display_number[1] = 0;
+            display_number[2] = first_bad >> 4;
+            display_number[3] = first_bad & 0xF;
+        }
+    }
+#endif
+
+        // Stop the clocks of everything the chosen mode leaves unused
+    power_set_mode(show_readings ? POWER_MODE_SAMPLING : POWER_MODE_DISPLAY);
+#ifdef CRASH_LOG
+    crash_log_event(CRASH_EV_POWER_MODE, power_mode());
+#endif
+#ifdef BURST_MODE
+    configure_rtc_wake(BURST_PERIOD_MS);
+#endif
+#ifdef WATCHDOG
+        // Sampling pauses between bursts and stops after a failed check
+    #ifdef BURST_MODE
+    configure_watchdog(HEARTBEAT_ALL & ~HEARTBEAT_BIT(HEARTBEAT_SAMPLING));
+    #else
+    configure_watchdog(show_readings ? HEARTBEAT_ALL
+        : HEARTBEAT_ALL & ~HEARTBEAT_BIT(HEARTBEAT_SAMPLING));
+    #endif
+    timer_start(&supervision, WDT_CHECK_MS, WDT_CHECK_MS, supervise);
+#endif
+
+        // Everything else is driven from interrupts through the event bus
+    while(1){
+#ifdef WATCHDOG
+        HEARTBEAT(HEARTBEAT_MAIN);
+#endif
+        event_dispatch();
+#ifdef CLOCK_SCALING
+    #ifdef CRASH_LOG
+        if(clock_governor_apply())  crash_log_event(CRASH_EV_CLOCK, get_cpu_clock());
+    #else
+        clock_governor_apply();
+    #endif
+#endif
+        if(show_readings)   display_task(&display_thread);
+#ifdef BURST_MODE
+        if(show_readings && !burst_remaining){
+            UINT32 wakeups;
+                // Deliver pending events before the clocks stop
+            event_dispatch();
+            while(adc_timer->STATUS.reg & (1 << 7u));    // TC6 stop synchronized
+            turn_off_ssd();
+            power_set_mode(POWER_MODE_IDLE);
+                // Any interrupt ends standby, only the RTC starts a burst.
+                //  WFI also wakes on an interrupt pending while masked, so
+                //  an RTC match just before it is not slept through.
+            wakeups = rtc_wakeups();
+            __disable_irq();
+            while(rtc_wakeups() == wakeups){
+                enter_standby();
+                __enable_irq();     // Let the waking handler run
+                __disable_irq();
+            }
+            __enable_irq();
+            power_set_mode(POWER_MODE_SAMPLING);
+    #ifdef WATCHDOG
+            watchdog_check(sample_overruns);
+    #endif
+    #ifdef CRASH_LOG
+            crash_log_event(CRASH_EV_BURST, burst_output);
+    #endif
+            burst_remaining = BURST_SIZE;
+            start_adc();
+            enable_adc_timer();
+        }
+#endif
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -111,7 +408,7 @@ void enable_adc_tc_clocks(void){
     PM->APBCMASK.reg |= (1 << 14u);  // TC6 is in the 14th position (see pg 129)
     
     uint32_t temp=0x16;   // ID for TC6 is 0x16  (see table 14-2)
-    temp |= 0<<8;         //  Selection Generic clock generator 0
+    temp |= PERIPH_GCLK<<8;    //  Selection of the fixed peripheral clock generator
     GCLK->CLKCTRL.reg=temp;   //  Setup in the CLKCTRL register
     GCLK->CLKCTRL.reg |= 0x1u << 14;    // enable it.
 }
@@ -153,74 +450,169 @@ void configure_adc_interrupt(void){
 
     adc_timer->PER.reg = 124;
 
-        // Set up timer 6 interrupt
+        // Set up timer 6 interrupt. Priority 1 leaves level 0 to the
+        //  WDT early warning, so it can still report a hang in here.
+    NVIC_SetPriority(TC6_IRQn, 1);
     NVIC->ISER[0] |= 1 << 19u;
     adc_timer->INTENSET.reg |= 1;
     adc_timer->INTFLAG.reg |= 0x1;
 }
 
-void adc_handler(void){
+RAMFUNC void adc_handler(void){
+    UINT16 adc_raw;
+    BOOLEAN__ converted;
+#ifdef FAULT_INJECTION
+    UINT8 repeat;
+#endif
+    if(adc_timer->INTFLAG.reg & 0x1){
+            // Clear on entry so a period that elapses while the
+            //  sample is processed is seen as an overrun
+        adc_timer->INTFLAG.reg = 0x1;   // Write one to clear only this flag
+            // Take the conversion started one period ago and start the
+            //  next, so the handler never waits on RESRDY. The last sample
+            //  of a burst starts none, the main loop starts the next burst's.
+        converted = take_adc(&adc_raw);
+#ifdef BURST_MODE
+        if(burst_remaining > 1) start_adc();
+#else
+        start_adc();
+#endif
+        if(converted){
+#ifdef FAULT_INJECTION
+            for(repeat = fault_tc_repeat(); repeat; --repeat)   process_sample(adc_raw);
+#else
+            process_sample(adc_raw);
+#endif
+        }
+        else    ++adc_misses;
+        if(adc_timer->INTFLAG.reg & 0x1){
+            event_publish(EVENT_OVERRUN, ++sample_overruns);
+#ifdef CRASH_LOG
+            crash_log_overruns(sample_overruns);
+            crash_log_event(CRASH_EV_OVERRUN, sample_overruns);
+#endif
+        }
+#ifdef WATCHDOG
+            // An ADC that stops converting stops this heartbeat
+        if(converted)   HEARTBEAT(HEARTBEAT_SAMPLING);
+#endif
+#ifdef BURST_MODE
+            // Stop without waiting for sync, the main loop does before standby
+        if(!--burst_remaining)  adc_timer->CTRLA.reg &= ~(1 << 1u);
+#endif
+    }
+}
+
+RAMFUNC void process_sample(UINT32 adc_raw){
         // Create static storage space
-    static UINT32 adc_raw = 0, adc_volt = 0;
+    static UINT16 dac_out = 0;
 
 #ifdef FILTER_LPF
-    // Low pass filter constants
-    static float x = 0, y = 0, y_prev = 0, x_prev = 0;
-
-#define SAMP_FREQ 1000
-#define BW 100
-    static const float omega = BW*2*PI/SAMP_FREQ;
-
+    // Low pass filter, see filters.h
+    static lpf_filter lpf = {0, 0};
+#elif defined(NOTCH_BFP)
+    // Notch filter in block floating point, same H(z) as notch_step()
+    static bfp_biquad notch = BFP_BIQUAD_INIT(1.0, NOTCH_B1, NOTCH_B2, NOTCH_A1, NOTCH_A2);
 #else
-    // Notch filter constants
-
-        // Let the index denote the Z delay, e.g. x[1] = X(Z-1)
-    static float x[3] = {0, 0, 0}, y[3] = {0, 0, 0};
+    // Notch filter, see filters.h
+    static notch_filter notch = {{0, 0, 0}, {0, 0, 0}};
+#endif
+#ifdef MEASURE_FILTER_CYCLES
+    UINT32 filter_start;
+#endif
+#ifdef REPLAY_INPUT
+    static UINT16 replay_index = 0;
+    static UINT32 replay_hash = FNV1A_INIT;
 #endif
 
-    if(adc_timer->INTFLAG.reg & 0x1){
-        bankB->OUT.reg ^= 1 << 16u;
-            // Read and convert raw pot value
-        adc_raw = read_adc();
+#ifdef DAC_PIPELINED
+        // Output the sample computed during the previous interrupt
+    output_to_dac(dac_out);
+#endif
+    bankB->OUTTGL.reg = 1 << 16u;
+#ifdef REPLAY_INPUT
+    adc_raw = replay_samples[replay_index];
+#endif
+#ifdef FAULT_INJECTION
+    adc_raw = fault_adc(adc_raw, RES_MAX);
+#endif
+    TRACE(TRACE_ADC, adc_raw);
 
-            // Output to dac
+#ifdef MEASURE_FILTER_CYCLES
+    filter_start = CYCLES_NOW();
+#endif
 #ifdef FILTER_LPF
-            // Low pass filter implementation
-        x = adc_raw;
-        y = (1-omega)*y_prev + omega*x_prev;
-        write_to_dac(mapf(y, 0, RES_MAX, 0, 1023));
-        y_prev = y;
-        x_prev = x;
+    dac_out = float_to_dac(lpf_step(&lpf, adc_raw), RES_MAX);
+#elif defined(NOTCH_BFP)
+    dac_out = int_to_dac(bfp_biquad_step(&notch, adc_raw), RES_MAX);
 #else
-            // Notch filter implementation
-        x[0] = adc_raw;
-            // H(z) =   z^2 - 1.906*z + 0.9981
-            //          ----------------------
-            //          z^2 - 1.790*z + 0.8819
-            // 20 Hz bandwidth
-        y[0] = 1.79f*y[1] - 0.8819f*y[2] + x[0] - 1.906f*x[1] + 0.9981*x[2];
-        bankB->OUT.reg |= 1 << 17u;
-        write_to_dac(mapf(y[0], 0, RES_MAX, 0, 1023));
-        bankB->OUT.reg &= ~(1 << 17u);
-        y[2] = y[1];
-        x[2] = x[1];
-        y[1] = y[0];
-        x[1] = x[0];
-#endif
-
-            // Update display
-        adc_volt = map32(adc_raw, 0, 0xFFFF, 0, 3300);
-        display_number[3] = adc_volt%10;
-        display_number[2] = (adc_volt%100)/10;
-        display_number[1] = (adc_volt%1000)/100;
-        display_number[0] = (adc_volt%10000)/1000;
-
-        adc_timer->INTFLAG.reg |= 0x1;
+    dac_out = float_to_dac(notch_step(&notch, adc_raw), RES_MAX);
+#endif
+#ifdef MEASURE_FILTER_CYCLES
+    update_cycle_stats(&filter_cycles, CYCLES_BETWEEN(filter_start, CYCLES_NOW()));
+#endif
+#ifdef REPLAY_INPUT
+    if(!replay_checksum)    replay_hash = fnv1a16(replay_hash, dac_out);
+    if(++replay_index == REPLAY_SIZE){
+        replay_index = 0;
+        replay_checksum = replay_hash;
     }
+#endif
+
+#ifndef DAC_PIPELINED
+        // Output to dac
+    output_to_dac(dac_out);
+#endif
+
+        // Update display
+    display_mv = map32(adc_raw, 0, 0xFFFF, 0, 3300);
+#ifdef BURST_MODE
+    burst_output = dac_out;
+#endif
+}
+
+    // PB17 is held high for the duration of the DAC write so the
+    //  output instant can be observed on a scope.
+RAMFUNC void output_to_dac(UINT16 val){
+#ifdef MEASURE_DAC_JITTER
+    static UINT32 prev_stamp = 0;
+    UINT32 stamp = CYCLES_NOW();
+    if(prev_stamp)  update_cycle_stats(&dac_period, CYCLES_BETWEEN(prev_stamp, stamp));
+    prev_stamp = stamp;
+#endif
+#ifdef FAULT_INJECTION
+    fault_dac_stall();
+#endif
+    bankB->OUTSET.reg = 1 << 17u;
+    if(!write_to_dac(val))  ++dac_skips;
+    TRACE(TRACE_DAC, val);
+    bankB->OUTCLR.reg = 1 << 17u;
 }
 
-void TC6_Handler(void){
+RAMFUNC void TC6_Handler(void){
+    TRACE(TRACE_TC6_ENTER, 0);
+#if defined(CLOCK_SCALING) || defined(CRASH_LOG)
+    UINT32 busy_start = timebase_now();
+    UINT32 busy_us;
+#endif
+#ifdef MEASURE_ISR_CYCLES
+    UINT32 start = CYCLES_NOW();
+    adc_handler();
+    update_cycle_stats(&isr_cycles, CYCLES_BETWEEN(start, CYCLES_NOW()));
+#else
     adc_handler();
+#endif
+#if defined(CLOCK_SCALING) || defined(CRASH_LOG)
+    busy_us = timebase_elapsed(busy_start);
+#endif
+#ifdef CLOCK_SCALING
+    governor_busy(busy_us);
+#endif
+#ifdef CRASH_LOG
+    crash_log_isr_time(busy_us);
+#endif
+    TRACE(TRACE_PORTB, bankB->OUT.reg);
+    TRACE(TRACE_TC6_EXIT, 0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -235,7 +627,7 @@ void enable_display_tc_clocks(void){
     PM->APBCMASK.reg |= (1 << 15u);  // PM_APBCMASK is in the 15 position
     
     uint32_t temp=0x16;   // ID for TC7 is 0x16  (see table 14-2)
-    temp |= 0<<8;         //  Selection Generic clock generator 0
+    temp |= PERIPH_GCLK<<8;    //  Selection of the fixed peripheral clock generator
     GCLK->CLKCTRL.reg=temp;   //  Setup in the CLKCTRL register
     GCLK->CLKCTRL.reg |= 0x1u << 14;    // enable it.
 }
@@ -250,7 +642,6 @@ void disable_display_timer(void){
     while(disp_timer->STATUS.reg & (1 << 7u));    // Synchronize before proceeding
 }
 
-    // In a future implementation, possibly write an event-driven system
     // Possibly rewrite for control over brightness
 void configure_display_interrupt(void){
     disp_timer = timer7_16; // Use the one of the count structures within the union
@@ -261,30 +652,110 @@ void configure_display_interrupt(void){
         // Set up timer 7 settings
     disp_timer->CTRLA.reg |=
           (0x1 << 12u)  // Set presynchronizer to prescaled clock
-        | (0x6 << 8u)   // Prescale clock by 128
+        | (0x3 << 8u)   // Prescale clock by 8
         | (0x0 << 2u)   // Start in 16-bit mode
         | (0x1 << 5u)   // Select the Match Frequncy waveform generator
                         //  Allow control over refresh speed and brightness
         ;
-    disp_timer->CC[0].reg = 0x60;
+    disp_timer->CC[0].reg = PERIPH_GCLK_HZ/8/TICK_HZ - 1;  // 1 ms tick
 
-        // Set up timer 7 interrupt
+        // Set up timer 7 interrupt, at the sampling interrupt's priority
+    NVIC_SetPriority(TC7_IRQn, 1);
     NVIC->ISER[0] |= 1 << 20u;
     disp_timer->INTENSET.reg |= 1;
     disp_timer->INTFLAG.reg |= 0x1;
 }
 
-void display_handler(void){
+void display_handler(sw_timer* timer){
     static UINT8 dig = 0;
-    if(disp_timer->INTFLAG.reg & 0x1){
-        display_dig(0, display_number[DISPLAY_DIGIT_SIZE_MAX-1-dig], dig, FALSE__, FALSE__);
-        dig = (dig == DISPLAY_DIGIT_SIZE_MAX-1) ? 0 : (dig+1);
+    display_dig(
+        display_number[DISPLAY_DIGIT_SIZE_MAX-1-dig], dig,
+        dig == DISPLAY_DIGIT_SIZE_MAX-1 && overrun_indicator, FALSE__
+        );
+#ifdef MEASURE_TASK_CYCLES
+    UINT32 task_start = CYCLES_NOW();
+#endif
+        // The digit select lines also power the keypad rows
+    keypad_task(&keypad, dig);
+#ifdef MEASURE_TASK_CYCLES
+    update_cycle_stats(&task_cycles, CYCLES_BETWEEN(task_start, CYCLES_NOW()));
+#endif
+    dig = (dig == DISPLAY_DIGIT_SIZE_MAX-1) ? 0 : (dig+1);
+}
+
+void scale_clock(sw_timer* timer){
+#ifdef CLOCK_SCALING
+    clock_governor_update(GOVERNOR_WINDOW_MS*1000u);
+#endif
+}
+
+void supervise(sw_timer* timer){
+#ifdef WATCHDOG
+    watchdog_check(sample_overruns);
+#endif
+}
+
+void take_keypress(event_type type, UINT32 data){
+    pressed_key = data;
+    key_pending = TRUE__;
+}
+
+    // Runs from the main loop. Decimal formatting needs four software
+    //  divisions, so it is done here at display rate rather than in the
+    //  sampling interrupt.
+PT_THREAD(display_task(pt* thread)){
+    static UINT32 deadline;
+    UINT32 mv;
+
+    PT_BEGIN(thread);
+    while(1){
+        deadline = timebase_deadline(DISPLAY_UPDATE_US);
+        PT_WAIT_UNTIL(thread, key_pending || deadline_passed(deadline));
+
+        if(key_pending){
+                // Row on the left digit, column bits on the right
+            key_pending = FALSE__;
+            display_number[0] = pressed_key >> 4;
+            display_number[1] = 0x10;   // Blank
+            display_number[2] = 0x10;
+            display_number[3] = pressed_key & 0xF;
+            deadline = timebase_deadline(KEY_SHOW_US);
+            PT_WAIT_UNTIL(thread, key_pending || deadline_passed(deadline));
+            continue;
+        }
+
+        mv = display_mv;
+        display_number[3] = mv%10;
+        display_number[2] = (mv%100)/10;
+        display_number[1] = (mv%1000)/100;
+        display_number[0] = (mv%10000)/1000;
     }
+    PT_END(thread);
+}
+
+void roll_up_stats(sw_timer* timer){
+    static UINT32 last_overruns = 0;
+    UINT32 overruns = sample_overruns;
+    overruns_per_second = overruns - last_overruns;
+    last_overruns = overruns;
+}
+
+void show_overrun(event_type type, UINT32 data){
+    overrun_indicator = TRUE__;
 }
 
 void TC7_Handler(void){
-    display_handler();
-        disp_timer->INTFLAG.reg |= 0x1;
+    TRACE(TRACE_TC7_ENTER, 0);
+    if(disp_timer->INTFLAG.reg & 0x1){
+        disp_timer->INTFLAG.reg = 0x1;  // Write one to clear only this flag
+#ifdef WATCHDOG
+        HEARTBEAT(HEARTBEAT_DISPLAY);
+#endif
+        timer_wheel_tick();
+    }
+    TRACE(TRACE_PORTA, bankA->OUT.reg);
+    TRACE(TRACE_PORTB, bankB->OUT.reg);
+    TRACE(TRACE_TC7_EXIT, 0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,97 @@
+#ifndef REPLAY_SAMPLE_TABLE_HDR7730219______
+#define REPLAY_SAMPLE_TABLE_HDR7730219______
+
+#include "PeriphBoard/extended_types.h"
+
+    // Generated by tools/make_replay.py, do not edit.
+    //  1000 12-bit samples at 1000 Hz: 50 Hz, 7 Hz and 180 Hz tones with +-20 LSB noise
+#define REPLAY_SIZE 1000
+
+static const UINT16 replay_samples[REPLAY_SIZE] = {
+    2053, 2534, 2773, 2785, 2810, 2934, 3131, 3134, 2808, 2364, 2084, 1958,
+    1920, 1752, 1440, 1263, 1393, 1714, 2085, 2254, 2328, 2532, 2938, 3368,
+    3539, 3374, 3164, 3079, 3081, 3003, 2648, 2181, 1812, 1738, 1838, 1849,
+    1723, 1668, 1838, 2297, 2738, 2947, 3003, 3062, 3269, 3516, 3560, 3280,
+    2846, 2561, 2440, 2330, 2041, 1649, 1350, 1364, 1613, 1831, 1882, 1886,
+    2106, 2523, 2943, 3146, 3056, 2907, 2893, 2962, 2847, 2478, 1957, 1564,
+    1460, 1457, 1300, 1086,  926, 1043, 1428, 1821, 1975, 2027, 2133, 2451,
+    2769, 2867, 2618, 2285, 2062, 2016, 1886, 1521, 1071,  730,  665,  838,
+     957,  906,  896, 1125, 1556, 2044, 2250, 2227, 2225, 2326, 2501, 2476,
+    2151, 1695, 1351, 1254, 1191, 1005,  698,  487,  600,  957, 1268, 1447,
+    1498, 1710, 2120, 2559, 2723, 2581, 2401, 2304, 2316, 2229, 1914, 1409,
+    1095, 1030, 1142, 1173, 1049, 1036, 1256, 1712, 2157, 2403, 2480, 2588,
+    2822, 3126, 3176, 2907, 2547, 2296, 2220, 2131, 1887, 1497, 1233, 1293,
+    1572, 1793, 1905, 1942, 2185, 2650, 3128, 3314, 3294, 3191, 3181, 3300,
+    3216, 2872, 2406, 2032, 1931, 1977, 1871, 1650, 1499, 1645, 2084, 2458,
+    2684, 2719, 2892, 3179, 3511, 3620, 3398, 3068, 2868, 2818, 2678, 2349,
+    1857, 1518, 1482, 1654, 1764, 1703, 1692, 1905, 2332, 2795, 2970, 2949,
+    2924, 3041, 3199, 3115, 2796, 2324, 1968, 1812, 1731, 1524, 1189,  954,
+    1010, 1323, 1626, 1745, 1788, 2001, 2366, 2748, 2875, 2707, 2484, 2347,
+    2354, 2228, 1855, 1357,  961,  882,  955,  951,  804,  721,  934, 1340,
+    1771, 1996, 2032, 2097, 2317, 2588, 2622, 2343, 1919, 1663, 1528, 1445,
+    1167,  787,  497,  552,  788, 1055, 1127, 1168, 1415, 1865, 2296, 2516,
+    2455, 2373, 2372, 2497, 2429, 2077, 1602, 1262, 1184, 1198, 1145,  911,
+     803,  972, 1382, 1815, 2054, 2125, 2302, 2635, 2988, 3104, 2946, 2641,
+    2475, 2404, 2347, 2028, 1601, 1277, 1266, 1453, 1617, 1589, 1616, 1848,
+    2328, 2808, 3058, 3071, 3068, 3212, 3378, 3360, 3048, 2608, 2289, 2180,
+    2129, 1966, 1642, 1440, 1537, 1881, 2209, 2370, 2428, 2632, 3009, 3410,
+    3593, 3435, 3197, 3115, 3093, 3006, 2610, 2111, 1781, 1690, 1756, 1750,
+    1634, 1545, 1729, 2136, 2599, 2805, 2798, 2851, 3091, 3306, 3341, 3032,
+    2621, 2301, 2185, 2104, 1796, 1379, 1048, 1080, 1321, 1530, 1564, 1586,
+    1802, 2201, 2647, 2816, 2716, 2595, 2594, 2639, 2537, 2181, 1680, 1307,
+    1179, 1140, 1052,  786,  642,  773, 1174, 1546, 1755, 1807, 1932, 2235,
+    2573, 2669, 2466, 2127, 1925, 1856, 1748, 1411,  936,  640,  581,  749,
+     902,  859,  880, 1111, 1587, 2028, 2252, 2275, 2253, 2400, 2571, 2575,
+    2243, 1830, 1510, 1407, 1335, 1182,  875,  688,  779, 1144, 1500, 1663,
+    1764, 1968, 2385, 2792, 2996, 2860, 2661, 2581, 2629, 2527, 2192, 1739,
+    1375, 1329, 1456, 1476, 1398, 1327, 1553, 2028, 2483, 2743, 2797, 2873,
+    3108, 3379, 3462, 3195, 2792, 2554, 2467, 2362, 2111, 1710, 1433, 1471,
+    1773, 1984, 2070, 2124, 2341, 2792, 3258, 3436, 3367, 3240, 3247, 3327,
+    3254, 2897, 2407, 2042, 1945, 1938, 1832, 1602, 1461, 1593, 1964, 2346,
+    2571, 2591, 2737, 3045, 3372, 3462, 3198, 2862, 2656, 2577, 2460, 2086,
+    1630, 1289, 1221, 1370, 1481, 1416, 1421, 1616, 2054, 2480, 2700, 2678,
+    2611, 2716, 2878, 2817, 2463, 2015, 1638, 1502, 1449, 1208,  894,  657,
+     735, 1073, 1374, 1510, 1565, 1730, 2120, 2497, 2634, 2511, 2254, 2175,
+    2143, 2028, 1695, 1195,  819,  735,  811,  839,  718,  644,  851, 1317,
+    1750, 1968, 2024, 2094, 2345, 2617, 2646, 2394, 1988, 1735, 1663, 1571,
+    1306,  922,  648,  696,  991, 1228, 1305, 1379, 1636, 2061, 2534, 2781,
+    2732, 2606, 2657, 2760, 2717, 2380, 1881, 1577, 1481, 1507, 1449, 1222,
+    1102, 1303, 1717, 2126, 2364, 2443, 2612, 2955, 3316, 3436, 3222, 2905,
+    2733, 2683, 2592, 2284, 1845, 1526, 1517, 1687, 1833, 1812, 1836, 2049,
+    2506, 2975, 3201, 3198, 3203, 3333, 3492, 3456, 3130, 2676, 2360, 2256,
+    2157, 1972, 1632, 1425, 1533, 1863, 2180, 2307, 2342, 2552, 2917, 3322,
+    3451, 3318, 3077, 2960, 2923, 2822, 2429, 1930, 1539, 1451, 1514, 1495,
+    1347, 1262, 1467, 1875, 2313, 2504, 2526, 2587, 2802, 3013, 3041, 2722,
+    2316, 2003, 1881, 1772, 1480, 1051,  753,  782, 1021, 1223, 1264, 1291,
+    1506, 1929, 2389, 2571, 2477, 2334, 2342, 2398, 2314, 1948, 1458, 1116,
+     998,  988,  898,  657,  517,  680, 1060, 1485, 1675, 1751, 1886, 2202,
+    2567, 2650, 2475, 2154, 1933, 1915, 1799, 1477, 1043,  738,  721,  878,
+    1030, 1037, 1048, 1270, 1742, 2227, 2487, 2506, 2474, 2615, 2817, 2836,
+    2514, 2062, 1770, 1675, 1643, 1475, 1151,  967, 1107, 1434, 1800, 1977,
+    2042, 2282, 2686, 3119, 3284, 3166, 2980, 2902, 2893, 2805, 2484, 2023,
+    1660, 1612, 1693, 1742, 1613, 1561, 1766, 2225, 2690, 2933, 2974, 3062,
+    3272, 3538, 3602, 3324, 2903, 2631, 2546, 2442, 2174, 1746, 1489, 1517,
+    1781, 2002, 2072, 2090, 2290, 2732, 3189, 3362, 3278, 3162, 3154, 3230,
+    3116, 2760, 2254, 1862, 1733, 1732, 1637, 1360, 1238, 1347, 1749, 2092,
+    2271, 2339, 2469, 2756, 3073, 3156, 2920, 2565, 2350, 2261, 2136, 1800,
+    1312,  960,  933, 1048, 1153, 1132, 1119, 1319, 1738, 2198, 2407, 2370,
+    2366, 2462, 2614, 2586, 2252, 1769, 1402, 1279, 1241, 1043,  688,  482,
+     579,  911, 1204, 1350, 1438, 1617, 2035, 2433, 2590, 2441, 2216, 2133,
+    2143, 2049, 1714, 1198,  853,  793,  899,  914,  798,  758,  996, 1436,
+    1913, 2117, 2207, 2296, 2550, 2805, 2866, 2624, 2245, 1954, 1893, 1818,
+    1575, 1186,  917,  968, 1277, 1506, 1620, 1684, 1902, 2385, 2860, 3091,
+    3021, 2922, 2945, 3071, 2991, 2672, 2186, 1856, 1757, 1813, 1730, 1490,
+    1369, 1541, 1946, 2371, 2578, 2669, 2830, 3149, 3514, 3594, 3396, 3074,
+    2879, 2862, 2746, 2412, 1950, 1603, 1576, 1758, 1875, 1846, 1833, 2085,
+    2514, 2979, 3175, 3162, 3153, 3272, 3436, 3400, 3027, 2560, 2228, 2078,
+    2011, 1799, 1458, 1238, 1325, 1657, 1939, 2076, 2110, 2285, 2671, 3050,
+    3197, 3027, 2759, 2657, 2630, 2493, 2139, 1623, 1243, 1167, 1224, 1211,
+    1037,  988, 1132, 1591, 1991, 2194, 2235, 2272, 2511, 2736, 2757, 2482,
+    2040, 1762, 1642, 1531, 1258,  812,  544,  589,  824, 1056, 1110, 1147,
+    1385, 1792, 2256, 2444, 2395, 2265, 2270, 2348, 2273, 1941, 1429, 1095,
+    1018, 1013,  904,  688,  560,  727, 1145, 1547, 1783, 1849, 2011, 2373,
+    2717, 2849, 2635, 2332, 2164, 2139, 2005, 1716, 1277,  984,  964, 1174,
+    1298, 1316, 1339, 1583,
+};
+
+#endif
@@ -0,0 +1,88 @@
+#include "devfilter.h"
+
+#include <stdlib.h>
+
+#include "filters.h"
+#include "bfp_filter.h"
+
+struct devfilter{
+    int32_t kind;
+    uint32_t res_max;
+    union{
+        lpf_filter lpf;
+        notch_filter notch;
+        bfp_biquad bfp;
+    } state;
+};
+
+DEVFILTER_API uint32_t devfilter_abi_version(void){
+    return DEVFILTER_ABI_VERSION;
+}
+
+DEVFILTER_API devfilter* devfilter_create(int32_t kind, uint32_t resolution){
+    devfilter* filt;
+    if(kind < DEVFILTER_LPF || kind > DEVFILTER_NOTCH_BFP)  return NULL;
+    if(resolution != 12 && resolution != 16)                return NULL;
+    filt = malloc(sizeof(*filt));
+    if(IS_NULL(filt))   return NULL;
+    filt->kind = kind;
+    filt->res_max = (1u << resolution) - 1;
+    devfilter_reset(filt);
+    return filt;
+}
+
+DEVFILTER_API void devfilter_destroy(devfilter* filt){
+    free(filt);
+}
+
+DEVFILTER_API void devfilter_reset(devfilter* filt){
+    bfp_biquad bfp = BFP_BIQUAD_INIT(1.0, NOTCH_B1, NOTCH_B2, NOTCH_A1, NOTCH_A2);
+    if(IS_NULL(filt))   return;
+    switch(filt->kind){
+        case DEVFILTER_LPF:     reset_lpf(&filt->state.lpf);        break;
+        case DEVFILTER_NOTCH:   reset_notch(&filt->state.notch);    break;
+        default:                filt->state.bfp = bfp;              break;
+    }
+}
+
+DEVFILTER_API int32_t devfilter_process(
+    devfilter* filt, const uint16_t* adc_in, uint16_t* dac_out, size_t count
+){
+    size_t i;
+    if(IS_NULL(filt) || IS_NULL(adc_in) || IS_NULL(dac_out))    return -1;
+        // Switch outside the loop so each block runs one tight kernel
+    switch(filt->kind){
+        case DEVFILTER_LPF:
+            for(i = 0; i < count; ++i)
+                dac_out[i] = float_to_dac(lpf_step(&filt->state.lpf, adc_in[i]), filt->res_max);
+            break;
+        case DEVFILTER_NOTCH:
+            for(i = 0; i < count; ++i)
+                dac_out[i] = float_to_dac(notch_step(&filt->state.notch, adc_in[i]), filt->res_max);
+            break;
+        default:
+            for(i = 0; i < count; ++i)
+                dac_out[i] = int_to_dac(bfp_biquad_step(&filt->state.bfp, adc_in[i]), filt->res_max);
+            break;
+    }
+    return 0;
+}
+
+DEVFILTER_API int32_t devfilter_process_float(
+    devfilter* filt, const uint16_t* adc_in, float* out, size_t count
+){
+    size_t i;
+    if(IS_NULL(filt) || IS_NULL(adc_in) || IS_NULL(out))    return -1;
+    switch(filt->kind){
+        case DEVFILTER_LPF:
+            for(i = 0; i < count; ++i)  out[i] = lpf_step(&filt->state.lpf, adc_in[i]);
+            break;
+        case DEVFILTER_NOTCH:
+            for(i = 0; i < count; ++i)  out[i] = notch_step(&filt->state.notch, adc_in[i]);
+            break;
+        default:
+            for(i = 0; i < count; ++i)  out[i] = (float)bfp_biquad_step(&filt->state.bfp, adc_in[i]);
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+    devfilter: the firmware filters as a reentrant host library.
+
+    Every instance owns its whole filter state; the library has no global
+    or static state, so different instances may be used from different
+    threads at the same time. A single instance must not be used by two
+    threads at once.
+
+    ABI rules: instances are opaque, all entry points take and return
+    only C scalar types and pointers, and enum values below are fixed.
+    New functions may be added; existing ones never change signature.
+    Bump DEVFILTER_ABI_VERSION only on an incompatible change.
+
+    Build:
+        cc -O2 -fPIC -shared -fvisibility=hidden -IPeriphBoard \
+            tools/devfilter.c PeriphBoard/filters.c PeriphBoard/bfp_filter.c \
+            PeriphBoard/utilities.c -o libdevfilter.so
+*/
+#ifndef DEVFILTER_HOST_LIBRARY_HDR3381920______
+#define DEVFILTER_HOST_LIBRARY_HDR3381920______
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+    #define DEVFILTER_API __declspec(dllexport)
+#else
+    #define DEVFILTER_API __attribute__((visibility("default")))
+#endif
+
+#define DEVFILTER_ABI_VERSION 1
+
+    // Filter selection, same as the FILTER_LPF/NOTCH_BFP switches in main.c
+#define DEVFILTER_LPF           0
+#define DEVFILTER_NOTCH         1
+#define DEVFILTER_NOTCH_BFP     2
+
+typedef struct devfilter devfilter;
+
+DEVFILTER_API uint32_t devfilter_abi_version(void);
+    // resolution is the ADC resolution in bits (12 or 16).
+    //  Returns NULL for an unknown kind or resolution, or out of memory.
+DEVFILTER_API devfilter* devfilter_create(int32_t kind, uint32_t resolution);
+DEVFILTER_API void devfilter_destroy(devfilter* filt);
+    // Back to the power-on state of the firmware
+DEVFILTER_API void devfilter_reset(devfilter* filt);
+    // Filter count raw ADC codes into the DAC codes the board would write.
+    //  Returns 0, or -1 for a NULL argument.
+DEVFILTER_API int32_t devfilter_process(
+    devfilter* filt, const uint16_t* adc_in, uint16_t* dac_out, size_t count);
+    // Same, but return the filter output in ADC codes before DAC mapping
+DEVFILTER_API int32_t devfilter_process_float(
+    devfilter* filt, const uint16_t* adc_in, float* out, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,113 @@
+/*
+    Throughput of libdevfilter with many concurrent instances.
+
+    Build:
+        cc -O2 -pthread -Itools -IPeriphBoard tools/devfilter_bench.c \
+            tools/devfilter.c PeriphBoard/filters.c PeriphBoard/bfp_filter.c \
+            PeriphBoard/utilities.c -lm -o devfilter_bench
+
+    Usage:
+        devfilter_bench [instances] [threads] [block]
+
+    Runs the same number of samples once through a single instance and
+    once spread round-robin over all instances (one block each in turn),
+    so the difference is the per-instance overhead: state cache misses
+    and call setup per block.
+*/
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "devfilter.h"
+
+#define TOTAL_SAMPLES (1u << 24)
+
+typedef struct{
+    devfilter** filters;
+    size_t count, block, rounds;
+    uint16_t* in;
+    uint16_t* out;
+} job;
+
+static void* run_job(void* arg){
+    job* j = arg;
+    size_t r, i;
+    for(r = 0; r < j->rounds; ++r)
+        for(i = 0; i < j->count; ++i)
+            devfilter_process(j->filters[i], j->in, j->out, j->block);
+    return NULL;
+}
+
+static double seconds(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+static double bench(int kind, size_t instances, size_t threads, size_t block){
+    devfilter** filters = calloc(instances, sizeof(devfilter*));
+    pthread_t* pool = calloc(threads, sizeof(pthread_t));
+    job* jobs = calloc(threads, sizeof(job));
+    size_t i, per_thread = instances/threads;
+    double t0;
+
+    for(i = 0; i < instances; ++i)  filters[i] = devfilter_create(kind, 12);
+    for(i = 0; i < threads; ++i){
+        size_t k;
+        jobs[i].filters = filters + i*per_thread;
+        jobs[i].count = per_thread;
+        jobs[i].block = block;
+        jobs[i].rounds = TOTAL_SAMPLES/(instances*block) ? TOTAL_SAMPLES/(instances*block) : 1;
+        jobs[i].in = malloc(block*sizeof(uint16_t));
+        jobs[i].out = malloc(block*sizeof(uint16_t));
+        for(k = 0; k < block; ++k)
+            jobs[i].in[k] = (uint16_t)(2048 + 1500*sin(2*M_PI*50*k/1000.0));
+    }
+
+    t0 = seconds();
+    for(i = 0; i < threads; ++i)
+        if(pthread_create(&pool[i], NULL, run_job, &jobs[i])){
+                // Each thread owns a share of the instances, so a partial
+                //  run would time less work than it reports
+            fprintf(stderr, "cannot start thread %zu\n", i);
+            exit(1);
+        }
+    for(i = 0; i < threads; ++i)    pthread_join(pool[i], NULL);
+    t0 = seconds() - t0;
+
+    for(i = 0; i < threads; ++i){
+        free(jobs[i].in);
+        free(jobs[i].out);
+    }
+    for(i = 0; i < instances; ++i)  devfilter_destroy(filters[i]);
+    free(filters);
+    free(pool);
+    free(jobs);
+        // ns per sample
+    return t0*1e9/((double)(instances/threads)*threads*block
+                   *(TOTAL_SAMPLES/(instances*block) ? TOTAL_SAMPLES/(instances*block) : 1));
+}
+
+int main(int argc, char** argv){
+    size_t instances = argc > 1 ? strtoul(argv[1], NULL, 0) : 10000;
+    size_t threads = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+    size_t block = argc > 3 ? strtoul(argv[3], NULL, 0) : 64;
+    static const char* names[] = { "lpf", "notch", "bfp" };
+    int kind;
+
+    if(!threads || instances < threads || !block){
+        fprintf(stderr, "need instances >= threads > 0 and block > 0\n");
+        return 2;
+    }
+    printf("ABI %u, %zu instances, %zu threads, %zu-sample blocks\n",
+        devfilter_abi_version(), instances, threads, block);
+    for(kind = DEVFILTER_LPF; kind <= DEVFILTER_NOTCH_BFP; ++kind){
+        double one = bench(kind, threads, threads, block);
+        double many = bench(kind, instances, threads, block);
+        printf("  %-6s %6.2f ns/sample (1 instance/thread)  %6.2f ns/sample (%zu instances)\n",
+            names[kind], one, many, instances);
+    }
+    return 0;
+}
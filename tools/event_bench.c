@@ -0,0 +1,71 @@
+/*
+    Throughput of the static event bus (PeriphBoard/event_bus.c) on the
+    host.
+
+    Build:
+        cc -O2 -Itools/host -IPeriphBoard tools/event_bench.c \
+            PeriphBoard/event_bus.c -o event_bench
+
+    Usage:
+        event_bench [events] [batch]
+
+    Publishes batch events (at most EVENT_POOL_SIZE, as the pool allows)
+    and then dispatches them to one subscriber per type, repeating until
+    the requested number of events has been delivered. Reports the time
+    per publish and per delivery, and checks that every event arrived in
+    order with its data and that nothing was dropped. On the board, the
+    publish to delivery latency comes from MEASURE_EVENT_LATENCY instead.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "event_bus.h"
+
+static UINT32 received, expected_data, errors;
+
+static void count_event(event_type type, UINT32 data){
+    if(data != expected_data++ || type != (event_type)(data % EVENT_TYPE_COUNT))
+        ++errors;
+    ++received;
+}
+
+static double seconds_since(const struct timespec* t0){
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (t1.tv_sec - t0->tv_sec) + (t1.tv_nsec - t0->tv_nsec)*1e-9;
+}
+
+int main(int argc, char** argv){
+    UINT32 events = argc > 1 ? strtoul(argv[1], NULL, 0) : 10000000u;
+    UINT32 batch = argc > 2 ? strtoul(argv[2], NULL, 0) : EVENT_POOL_SIZE;
+    UINT32 sent = 0, i, n;
+    double publish_s = 0, dispatch_s = 0;
+    struct timespec t0;
+
+    if(!batch || batch > EVENT_POOL_SIZE){
+        fprintf(stderr, "batch must be 1 to %d\n", EVENT_POOL_SIZE);
+        return 2;
+    }
+    configure_event_bus();
+    for(i = 0; i < EVENT_TYPE_COUNT; ++i)   event_subscribe((event_type)i, count_event);
+
+    while(sent < events){
+        n = events - sent < batch ? events - sent : batch;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for(i = 0; i < n; ++i, ++sent)
+            event_publish((event_type)(sent % EVENT_TYPE_COUNT), sent);
+        publish_s += seconds_since(&t0);
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        event_dispatch();
+        dispatch_s += seconds_since(&t0);
+    }
+
+    printf("%u events in batches of %u\n", events, batch);
+    printf("  publish   %6.1f ns/event\n", 1e9*publish_s/events);
+    printf("  dispatch  %6.1f ns/event\n", 1e9*dispatch_s/events);
+    printf("  total     %6.2f M events/s\n", events/(publish_s + dispatch_s)/1e6);
+    printf("  delivered %u, dropped %u, out of order %u\n", received, event_drops(), errors);
+    return received != events || event_drops() || errors;
+}
@@ -0,0 +1,369 @@
+/*
+    Fleet simulation: many independent virtual boards, each with its own
+    input signal, filter state and interrupt timing, run across all cores.
+
+    Build:
+        cc -O2 -pthread -IPeriphBoard tools/fleet_sim.c PeriphBoard/filters.c \
+            PeriphBoard/bfp_filter.c PeriphBoard/utilities.c -lm -o fleet_sim
+
+    Usage:
+        fleet_sim [lpf|notch|bfp] [options]
+            --devices N         Number of boards (default 10000)
+            --seconds S         Simulated time per board (default 10)
+            --threads T         Worker threads (default: online cores)
+            --isr-cycles C      Mean TC6 handler cost in CPU cycles
+            --isr-spread C      Data dependent spread of that cost (+-C)
+            --disp-cycles C     TC7 handler cost, which can delay TC6
+            --noise LSB         Largest input noise amplitude in the population
+            --cpu-mhz F         CPU clock, 8 (OSC8M) or 48 (DFLL48M)
+            --adc-avg N         ADC conversions averaged per sample (1-256)
+            --mode M            Peripherals clocked as in POWER_MODE_M:
+                                sampling (default), display or idle
+            --periph MASK       Or any set of them, bits as in periph_id
+            --sleep             Idle sleep between interrupts instead of
+                                spinning in the main loop
+            --burst N,MS        BURST_MODE: N samples every MS milliseconds,
+                                standby in between
+            --wake-us US        Wake-up and clock gating time per burst
+                                (default 100), CPU active
+
+    The cycle costs default to rough soft-float figures; replace them
+    with MEASURE_ISR_CYCLES results from a board. A sample overruns when
+    the handler has not finished before the next TC6 period starts.
+
+    Each board draws its signal level, mains frequency, noise and clock
+    error from its own seeded generator, so results do not depend on the
+    thread count. Boards are handed out to the workers in small chunks
+    from a shared atomic counter, so fast threads keep taking work until
+    the fleet is done.
+
+    Energy model: each sample period, a board's supply current is the
+    CPU (active in the handlers, otherwise in the main loop or idle
+    sleep), the oscillators, the idle current of every clocked
+    peripheral, and the charge of that period's ADC conversions and DAC
+    update. All figures come from PeriphBoard/power_figures.h. Sampling
+    needs TC6 and the ADC clocked, the display interrupt TC7, and DAC
+    updates the DAC. The average is over the whole run. The peak is the
+    highest single sample period of any board, so it moves with display
+    interrupt collisions and the handler cost spread. The average with
+    every peripheral left clocked is reported next to it; the difference
+    is what power_gate.c saves in the chosen mode. Handler cycle counts
+    are taken as given at every clock, so add the flash wait state cost
+    to --isr-cycles when modelling 48 MHz.
+
+    With --burst, --seconds counts sampling time, and the signal moves
+    on by a whole burst period from one burst to the next while the
+    filter state carries over, as on the board. The average then
+    weighs the bursts and the wake-up time against STANDBY_UA for the
+    rest of each period.
+*/
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "filters.h"
+#include "bfp_filter.h"
+#include "power_figures.h"
+#include "power_gate.h"
+
+#define RES_MAX         4095
+#define PERIPH_HZ       8000000.0   // PERIPH_GCLK, drives TC6 and TC7
+#define CHUNK           16
+    // Samples of the board's DC level run through the filter before the
+    //  signal starts, so the start-up transient from zero state is not
+    //  counted as clipping or output noise
+#define SETTLE_SAMPLES  (SAMP_FREQ/5)
+
+
+typedef enum{ FILT_LPF, FILT_NOTCH, FILT_BFP } filter_kind;
+
+typedef struct{
+    filter_kind kind;
+    UINT32 devices, samples;
+    double isr_cycles, isr_spread, disp_cycles, noise;
+    double cpu_mhz;
+    UINT32 adc_avg;
+    int sleep;
+    UINT16 periph;          // Clocked peripherals, PERIPH_BIT() mask
+    UINT32 burst_size;      // Samples per burst, 0 to sample continuously
+    double burst_ms, wake_us;
+} fleet_config;
+
+    // Results of one board
+typedef struct{
+    UINT32 overruns;
+    UINT32 clipped;         // DAC codes pinned at 0 or full scale
+    double out_rms;         // RMS of the DAC output around its mean
+    double average_ua;      // Supply current over the whole run
+    double peak_ua;         // Highest single sample period
+} device_result;
+
+typedef struct{
+    const fleet_config* config;
+    device_result* results;
+    atomic_uint next;
+} fleet;
+
+    // Per-board generator, same xorshift32 as fault_inject.c
+static UINT32 next_random(UINT32* state){
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static double uniform(UINT32* state){
+    return (next_random(state) >> 8)*(1.0/16777216.0);
+}
+
+static void run_device(const fleet_config* c, UINT32 id, device_result* r){
+    lpf_filter lpf;
+    notch_filter notch;
+    bfp_biquad bfp = BFP_BIQUAD_INIT(1.0, NOTCH_B1, NOTCH_B2, NOTCH_A1, NOTCH_A2);
+    UINT32 rng = 0x9E3779B9u ^ (id*2654435761u);
+    static const double periph_ua[PERIPH_COUNT] = PERIPH_UA_TABLE;
+    int sampling = (c->periph & PERIPH_BIT(PERIPH_TC6)) && (c->periph & PERIPH_BIT(PERIPH_ADC));
+    int display = (c->periph & PERIPH_BIT(PERIPH_TC7)) != 0;
+    int dac = sampling && (c->periph & PERIPH_BIT(PERIPH_DAC));
+    UINT32 n, p;
+    double level, amp, mains, noise, clock, period, disp_period, next_disp, disp_due;
+    double sum = 0, sum_sq = 0, total_ua = 0, base_ua, convert_ua;
+
+    if(!rng)    rng = 1;
+    reset_lpf(&lpf);
+    reset_notch(&notch);
+    memset(r, 0, sizeof(*r));
+
+        // Draw this board's environment
+    level = 1000 + 2000*uniform(&rng);
+    amp = 100 + 900*uniform(&rng);
+    mains = uniform(&rng) < 0.5 ? 50 : 60;
+    noise = c->noise*uniform(&rng);
+    clock = 1 + 0.02*(uniform(&rng) - 0.5);             // OSC8M +-1 %
+    period = c->cpu_mhz*1e6/SAMP_FREQ;                   // Cycles per sample
+    disp_period = c->cpu_mhz*1e6/PERIPH_HZ*8.0*1000;     // TC7 match period
+    next_disp = disp_period*uniform(&rng);
+    disp_due = next_disp;
+
+        // Current that does not depend on what the CPU does
+    base_ua = OSC8M_UA + (c->cpu_mhz > 8 ? DFLL48M_UA : 0);
+    for(p = 0; p < PERIPH_COUNT; ++p)
+        if(c->periph & PERIPH_BIT(p))   base_ua += periph_ua[p];
+    convert_ua = (sampling ? ADC_CONVERT_UA*c->adc_avg*ADC_CONVERSION_US*1e-6*SAMP_FREQ : 0)
+        + (dac ? DAC_UPDATE_UA*DAC_SETTLE_US*1e-6*SAMP_FREQ : 0);
+
+    for(n = 0; n < SETTLE_SAMPLES; ++n){
+        switch(c->kind){
+            case FILT_LPF:      lpf_step(&lpf, (INT32)level);              break;
+            case FILT_NOTCH:    notch_step(&notch, (INT32)level);          break;
+            default:            bfp_biquad_step(&bfp, (INT32)level);       break;
+        }
+    }
+
+    for(n = 0; n < c->samples; ++n){
+            // Signal time, which skips the standby between bursts
+        double t = c->burst_size
+            ? (n/c->burst_size)*c->burst_ms*1e-3 + (n%c->burst_size)/(SAMP_FREQ*clock)
+            : n/(SAMP_FREQ*clock);
+        double start = n*period, cost, busy = 0, active = 0, ua;
+        INT32 in = (INT32)(level + amp*sin(2*M_PI*mains*t)
+                           + noise*(2*uniform(&rng) - 1));
+        UINT16 out;
+
+        if(in < 0)          in = 0;
+        if(in > RES_MAX)    in = RES_MAX;
+
+        switch(c->kind){
+            case FILT_LPF:      out = float_to_dac(lpf_step(&lpf, in), RES_MAX);    break;
+            case FILT_NOTCH:    out = float_to_dac(notch_step(&notch, in), RES_MAX); break;
+            default:            out = int_to_dac(bfp_biquad_step(&bfp, in), RES_MAX); break;
+        }
+        if(out == 0 || out == DAC_MAX)  ++r->clipped;
+        sum += out;
+        sum_sq += (double)out*out;
+
+            // A display interrupt due just before this sample runs first
+        while(next_disp < start)    next_disp += disp_period;
+        if(next_disp - start < c->disp_cycles)  busy = c->disp_cycles - (next_disp - start);
+        cost = busy + c->isr_cycles + c->isr_spread*(2*uniform(&rng) - 1);
+        if(sampling){
+            if(cost > period)   ++r->overruns;
+            active = cost - busy < period ? cost - busy : period;
+        }
+            // Every display interrupt runs, whether or not it delayed a sample
+        for(; display && disp_due < start + period; disp_due += disp_period)
+            active += c->disp_cycles;
+        active /= period;
+        if(active > 1)  active = 1;
+
+        ua = base_ua + convert_ua + c->cpu_mhz*(active*CPU_ACTIVE_UA_PER_MHZ
+            + (1 - active)*(c->sleep ? CPU_IDLE_UA_PER_MHZ : CPU_ACTIVE_UA_PER_MHZ));
+        total_ua += ua;
+        if(ua > r->peak_ua) r->peak_ua = ua;
+    }
+    sum /= c->samples;
+    r->out_rms = sqrt(sum_sq/c->samples - sum*sum);
+    r->average_ua = total_ua/c->samples;
+    if(c->burst_size){
+        double burst_s = (double)c->burst_size/SAMP_FREQ, wake_s = c->wake_us*1e-6;
+        double period_s = c->burst_ms*1e-3;
+        r->average_ua = (r->average_ua*burst_s
+            + (base_ua + c->cpu_mhz*CPU_ACTIVE_UA_PER_MHZ)*wake_s
+            + STANDBY_UA*(period_s - burst_s - wake_s))/period_s;
+    }
+}
+
+static void* worker(void* arg){
+    fleet* f = arg;
+    for(;;){
+        UINT32 first = atomic_fetch_add(&f->next, CHUNK), id;
+        if(first >= f->config->devices) break;
+        for(id = first; id < first + CHUNK && id < f->config->devices; ++id)
+            run_device(f->config, id, &f->results[id]);
+    }
+    return NULL;
+}
+
+static int compare_double(const void* a, const void* b){
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv){
+    fleet_config c = { FILT_LPF, 10000, 10*SAMP_FREQ, 3000, 1000, 600, 40, 8, 1, 0, POWER_MODE_SAMPLING,
+                       0, 0, 100 };
+    long threads = sysconf(_SC_NPROCESSORS_ONLN), started;
+    pthread_t* pool;
+    fleet f;
+    UINT32 i, overrun_boards = 0, clipped_boards = 0;
+    unsigned long long overruns = 0;
+    static const double periph_ua[PERIPH_COUNT] = PERIPH_UA_TABLE;
+    double* rms, elapsed, average_ua = 0, worst_ua = 0, peak_ua = 0, ungated_ua, awake;
+    struct timespec t0, t1;
+
+    for(i = 1; i < (UINT32)argc; ++i){
+        if(!strcmp(argv[i], "--devices") && i+1 < (UINT32)argc)           c.devices = strtoul(argv[++i], NULL, 0);
+        else if(!strcmp(argv[i], "--seconds") && i+1 < (UINT32)argc)      c.samples = (UINT32)(atof(argv[++i])*SAMP_FREQ);
+        else if(!strcmp(argv[i], "--threads") && i+1 < (UINT32)argc)      threads = atol(argv[++i]);
+        else if(!strcmp(argv[i], "--isr-cycles") && i+1 < (UINT32)argc)   c.isr_cycles = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--isr-spread") && i+1 < (UINT32)argc)   c.isr_spread = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--disp-cycles") && i+1 < (UINT32)argc)  c.disp_cycles = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--noise") && i+1 < (UINT32)argc)        c.noise = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--cpu-mhz") && i+1 < (UINT32)argc)      c.cpu_mhz = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--adc-avg") && i+1 < (UINT32)argc)      c.adc_avg = strtoul(argv[++i], NULL, 0);
+        else if(!strcmp(argv[i], "--periph") && i+1 < (UINT32)argc)       c.periph = strtoul(argv[++i], NULL, 0);
+        else if(!strcmp(argv[i], "--mode") && i+1 < (UINT32)argc){
+            ++i;
+            if(!strcmp(argv[i], "sampling"))        c.periph = POWER_MODE_SAMPLING;
+            else if(!strcmp(argv[i], "display"))    c.periph = POWER_MODE_DISPLAY;
+            else if(!strcmp(argv[i], "idle"))       c.periph = POWER_MODE_IDLE;
+            else{
+                fprintf(stderr, "unknown mode %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else if(!strcmp(argv[i], "--burst") && i+1 < (UINT32)argc){
+            if(sscanf(argv[++i], "%u,%lf", &c.burst_size, &c.burst_ms) != 2 || !c.burst_size){
+                fprintf(stderr, "--burst needs SIZE,PERIOD_MS\n");
+                return 2;
+            }
+        }
+        else if(!strcmp(argv[i], "--wake-us") && i+1 < (UINT32)argc)      c.wake_us = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--sleep"))    c.sleep = 1;
+        else if(!strcmp(argv[i], "lpf"))    c.kind = FILT_LPF;
+        else if(!strcmp(argv[i], "notch"))  c.kind = FILT_NOTCH;
+        else if(!strcmp(argv[i], "bfp"))    c.kind = FILT_BFP;
+        else{
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if(threads < 1)     threads = 1;
+    if(!c.devices || !c.samples){
+        fprintf(stderr, "need at least one device and one sample\n");
+        return 2;
+    }
+    if(c.cpu_mhz <= 0 || !c.adc_avg || c.adc_avg > 256){
+        fprintf(stderr, "need a positive clock and 1 to 256 ADC conversions\n");
+        return 2;
+    }
+        // The handler takes each result one period after starting it
+    if(c.adc_avg*ADC_CONVERSION_US >= 1e6/SAMP_FREQ){
+        fprintf(stderr, "%u averaged conversions do not fit in a sample period\n", c.adc_avg);
+        return 2;
+    }
+    if(c.burst_size && c.burst_ms*1e3 < c.burst_size*1e6/SAMP_FREQ + c.wake_us){
+        fprintf(stderr, "a burst of %u samples does not fit in %g ms\n", c.burst_size, c.burst_ms);
+        return 2;
+    }
+    if(c.periph >= PERIPH_BIT(PERIPH_COUNT)){
+        fprintf(stderr, "peripheral mask has bits beyond PERIPH_COUNT\n");
+        return 2;
+    }
+
+    f.config = &c;
+    f.results = calloc(c.devices, sizeof(device_result));
+    atomic_init(&f.next, 0);
+    pool = calloc(threads, sizeof(pthread_t));
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+        // Workers take boards until none are left, so the fleet finishes
+        //  with however many threads could be started
+    for(started = 0; started < threads; ++started)
+        if(pthread_create(&pool[started], NULL, worker, &f))    break;
+    if(!started){
+        fprintf(stderr, "cannot start a worker thread\n");
+        return 1;
+    }
+    for(i = 0; i < (UINT32)started; ++i)    pthread_join(pool[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    elapsed = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec)*1e-9;
+
+    rms = calloc(c.devices, sizeof(double));
+    for(i = 0; i < c.devices; ++i){
+        overruns += f.results[i].overruns;
+        overrun_boards += f.results[i].overruns != 0;
+        clipped_boards += f.results[i].clipped != 0;
+        rms[i] = f.results[i].out_rms;
+        average_ua += f.results[i].average_ua;
+        if(f.results[i].average_ua > worst_ua)  worst_ua = f.results[i].average_ua;
+        if(f.results[i].peak_ua > peak_ua)      peak_ua = f.results[i].peak_ua;
+    }
+    average_ua /= c.devices;
+        // The same board with every peripheral left clocked. A clocked but
+        //  unused peripheral draws only its idle current.
+    ungated_ua = average_ua;
+    awake = c.burst_size ? (c.burst_size*1e6/SAMP_FREQ + c.wake_us)/(c.burst_ms*1e3) : 1;
+    for(i = 0; i < PERIPH_COUNT; ++i)
+        if(!(c.periph & PERIPH_BIT(i))) ungated_ua += periph_ua[i]*awake;
+    qsort(rms, c.devices, sizeof(double), compare_double);
+
+    printf("%u boards x %u samples on %ld threads: %.2f s (%.1f M samples/s)\n",
+        c.devices, c.samples, started, elapsed, (double)c.devices*c.samples/elapsed/1e6);
+        // Without TC6 and the ADC the board does not sample
+    if((c.periph & PERIPH_BIT(PERIPH_TC6)) && (c.periph & PERIPH_BIT(PERIPH_ADC))){
+        printf("  boards with overruns   %u (%.2f %%), %llu overruns total\n",
+            overrun_boards, 100.0*overrun_boards/c.devices, overruns);
+        printf("  boards with clipping   %u (%.2f %%)\n",
+            clipped_boards, 100.0*clipped_boards/c.devices);
+        printf("  output RMS (DAC codes) p5 %.1f  p50 %.1f  p95 %.1f\n",
+            rms[c.devices/20], rms[c.devices/2], rms[c.devices - 1 - c.devices/20]);
+    }
+    if(c.burst_size)
+        printf("  bursts                 %u samples every %g ms, %.2f %% awake\n",
+            c.burst_size, c.burst_ms, 100*awake);
+    printf("  supply current (uA)    average %.1f  worst board %.1f  peak %.0f"
+        "  (peripherals 0x%02X)\n", average_ua, worst_ua, peak_ua, c.periph);
+    printf("  without clock gating   average %.1f, gating saves %.1f (%.1f %%)\n",
+        ungated_ua, ungated_ua - average_ua, 100*(ungated_ua - average_ua)/ungated_ua);
+
+    free(rms);
+    free(pool);
+    free(f.results);
+    return 0;
+}
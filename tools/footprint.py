@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""Flash and RAM footprint report for the firmware.
+
+Reports text, rodata, data and bss for every object file, the largest static
+buffers in the linked image, and a worst-case stack estimate. The exit status
+is non-zero when a budget from the budget file is exceeded, so the script can
+be the post-build step of the project:
+
+    python tools/footprint.py --budget tools/memory_budget.txt \\
+        --elf Debug/app.elf Debug/*.o
+
+Build the objects with -fcallgraph-info=su (GCC 10 or later) to get the stack
+estimate. The .ci files are picked up next to each object. Older compilers
+can use -fstack-usage instead. The .su files then give per-function frames
+without a call graph.
+
+To compare filter configurations, build each one and pass every image as
+NAME=PATH, e.g. --elf LPF=lpf.elf --elf NOTCH_BFP=bfp.elf.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+    # Section name prefixes mapped onto the reported columns.
+    #  .ramfunc is code that is copied into SRAM at startup,
+    #  so it costs both flash and RAM.
+CATEGORIES = (
+    ('ramfunc', ('.ramfunc',)),
+    ('text', ('.text', '.vectors', '.glue', '.vfp11', '.v4_bx', '.iplt')),
+    ('rodata', ('.rodata',)),
+    ('data', ('.data', '.relocate')),
+    ('bss', ('.bss', '.zero', 'COMMON', '.noinit')),
+)
+COLUMNS = ('text', 'rodata', 'data', 'bss', 'ramfunc')
+
+    # Interrupt handlers and main all share the main stack. In the worst
+    #  case every handler nests on top of the deepest main path.
+STACK_ROOTS = ('main', 'TC6_Handler', 'TC7_Handler', 'HardFault_Handler',
+               'WDT_Handler', 'RTC_Handler', 'SysTick_Handler')
+    # Bytes the core pushes on exception entry
+EXCEPTION_FRAME = 32
+
+
+def categorize(section):
+    for name, prefixes in CATEGORIES:
+        if any(section.startswith(p) for p in prefixes):
+            return name
+    return None
+
+
+def section_sizes(size_tool, path):
+    """Sum the sections of one object or image into the report columns."""
+    out = subprocess.run([size_tool, '-A', path], check=True,
+                         capture_output=True, text=True).stdout
+    sizes = dict.fromkeys(COLUMNS, 0)
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) < 2 or not fields[1].isdigit():
+            continue
+        column = categorize(fields[0])
+        if column:
+            sizes[column] += int(fields[1])
+    return sizes
+
+
+def flash_ram(sizes):
+    flash = sizes['text'] + sizes['rodata'] + sizes['data'] + sizes['ramfunc']
+    ram = sizes['data'] + sizes['bss'] + sizes['ramfunc']
+    return flash, ram
+
+
+def static_buffers(nm_tool, path, count):
+    """Largest data and bss symbols of the linked image."""
+    out = subprocess.run([nm_tool, '-S', '--size-sort', '-r', path],
+                         check=True, capture_output=True, text=True).stdout
+    buffers = []
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in 'bBdDrR':
+            buffers.append((fields[3], fields[2], int(fields[1], 16)))
+    return buffers[:count]
+
+
+def parse_callgraph(paths):
+    """Read -fcallgraph-info=su files into frame sizes and call edges."""
+    frames, calls = {}, {}
+    node = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"')
+    edge = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+    frame = re.compile(r'\\n(\d+) bytes')
+    for path in paths:
+        text = open(path).read()
+        for title, label in node.findall(text):
+            match = frame.search(label)
+            if match:
+                frames[title] = int(match.group(1))
+        for src, dst in edge.findall(text):
+            calls.setdefault(src, set()).add(dst)
+    return frames, calls
+
+
+def parse_stack_usage(paths):
+    """Read -fstack-usage files into frame sizes (no call edges)."""
+    frames = {}
+    for path in paths:
+        for line in open(path):
+            fields = line.rstrip('\n').split('\t')
+            if len(fields) >= 2 and fields[1].isdigit():
+                frames[fields[0].rsplit(':', 1)[-1]] = int(fields[1])
+    return frames
+
+
+def worst_stack(root, frames, calls, unknown, seen=()):
+    """Deepest stack from root. Unknown callees are counted as zero."""
+    if root in seen:
+        unknown.add(root + ' (recursion)')
+        return 0
+    if root not in frames:
+        unknown.add(root)
+    deepest = 0
+    for callee in calls.get(root, ()):
+        deepest = max(deepest,
+                      worst_stack(callee, frames, calls, unknown, seen + (root,)))
+    return frames.get(root, 0) + deepest
+
+
+def stack_estimate(objects):
+    """Worst-case main stack use from the call graph files next to objects."""
+    ci = [os.path.splitext(o)[0] + '.ci' for o in objects]
+    ci = [p for p in ci if os.path.exists(p)]
+    if ci:
+        frames, calls = parse_callgraph(ci)
+            # Titles may be qualified with the file name
+        names = {t.rsplit(':', 1)[-1]: t for t in frames}
+        names.update({t.rsplit(':', 1)[-1]: t for t in calls})
+        unknown = set()
+        roots = {}
+        for root in STACK_ROOTS:
+            if root in names:
+                roots[root] = worst_stack(names[root], frames, calls, unknown)
+        return roots, sorted(unknown)
+    su = [os.path.splitext(o)[0] + '.su' for o in objects]
+    su = [p for p in su if os.path.exists(p)]
+    if su:
+        frames = parse_stack_usage(su)
+        return {r: frames[r] for r in STACK_ROOTS if r in frames}, \
+            ['no call graph, frames of callees not included']
+    return None, []
+
+
+def read_budget(path):
+    budget = {}
+    for line in open(path):
+        line = line.split('#', 1)[0].strip()
+        if line:
+            key, value = (s.strip() for s in line.split('=', 1))
+            budget[key] = int(value, 0)
+    return budget
+
+
+def print_table(title, rows):
+    print(title)
+    print('  %-24s' % '' + ''.join('%9s' % c for c in COLUMNS + ('flash', 'ram')))
+    for name, sizes in rows:
+        flash, ram = flash_ram(sizes)
+        print('  %-24s' % name
+              + ''.join('%9d' % sizes[c] for c in COLUMNS)
+              + '%9d%9d' % (flash, ram))
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('objects', nargs='*', help='object files (.o)')
+    parser.add_argument('--elf', action='append', default=[],
+                        help='linked image, optionally NAME=PATH')
+    parser.add_argument('--budget', help='budget file (key = bytes)')
+    parser.add_argument('--buffers', type=int, default=10,
+                        help='number of static buffers to list')
+    parser.add_argument('--prefix', default='arm-none-eabi-',
+                        help='binutils prefix')
+    args = parser.parse_args()
+
+    size_tool, nm_tool = args.prefix + 'size', args.prefix + 'nm'
+    failures = []
+
+    if args.objects:
+        rows = [(os.path.basename(o), section_sizes(size_tool, o))
+                for o in args.objects]
+        total = dict.fromkeys(COLUMNS, 0)
+        for _, sizes in rows:
+            for c in COLUMNS:
+                total[c] += sizes[c]
+        print_table('Per source file', rows + [('total', total)])
+
+    images = []
+    for spec in args.elf:
+        name, _, path = spec.rpartition('=')
+        images.append((name or os.path.basename(path), path))
+    if images:
+        rows = [(name, section_sizes(size_tool, path)) for name, path in images]
+        print_table('Per configuration', rows)
+        for name, path in images:
+            print('Largest static buffers in %s' % name)
+            for symbol, kind, size in static_buffers(nm_tool, path, args.buffers):
+                print('  %-32s %s %7d' % (symbol, kind, size))
+            print()
+
+    roots, notes = stack_estimate(args.objects)
+    worst = None
+    if roots:
+        print('Stack high-water estimate (bytes)')
+        for root, depth in sorted(roots.items()):
+            print('  %-24s %7d' % (root, depth))
+        handlers = [d + EXCEPTION_FRAME for r, d in roots.items() if r != 'main']
+        worst = roots.get('main', 0) + sum(handlers)
+        print('  %-24s %7d' % ('all handlers nested', worst))
+        for note in notes:
+            print('  not counted: %s' % note)
+        print()
+
+    if args.budget:
+        budget = read_budget(args.budget)
+        for name, path in images:
+            flash, ram = flash_ram(section_sizes(size_tool, path))
+            if 'flash' in budget and flash > budget['flash']:
+                failures.append('%s: flash %d > %d' % (name, flash, budget['flash']))
+            if 'ram' in budget and ram > budget['ram']:
+                failures.append('%s: ram %d > %d' % (name, ram, budget['ram']))
+        if worst is not None and 'stack' in budget and worst > budget['stack']:
+            failures.append('stack %d > %d' % (worst, budget['stack']))
+
+    for failure in failures:
+        print('BUDGET EXCEEDED: ' + failure, file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,203 @@
+/*
+    Frequency response of the firmware filters, measured by running the
+    filter sources from PeriphBoard on the host.
+
+    Build:
+        cc -O2 -IPeriphBoard tools/freq_response.c PeriphBoard/filters.c \
+            PeriphBoard/bfp_filter.c PeriphBoard/utilities.c -lm -o freq_response
+
+    Usage:
+        freq_response [lpf|notch|bfp] [options]
+            --stage filter      Response of the filter output (default)
+            --stage dac         Include the mapping and truncation to the
+                                10-bit DAC code done in process_sample()
+            --points N          FFT length, power of 2 (default 65536)
+            --csv FILE          Write freq_hz, magnitude_db, phase_deg,
+                                group_delay_samples
+            --expect-cutoff F   Fail unless the -3 dB point is within
+            --tol T             T Hz (default 5) of F
+            --expect-notch F    Fail unless the deepest point is within T Hz of F
+            --min-depth D       Fail unless the notch is at least D dB deep
+
+    The filter is driven around mid-scale twice, once with a step-free DC
+    input and once with an impulse added. The difference is the impulse
+    response of exactly what the firmware computes, quantization included.
+    Exit status is 1 when a check fails.
+
+    Plot with e.g.
+        gnuplot -e "set datafile separator ','; set logscale x; \
+            plot 'resp.csv' using 1:2 with lines"
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "filters.h"
+#include "bfp_filter.h"
+
+#define RES_MAX     4095    // 12-bit ADC as configured in main()
+#define IMPULSE     (RES_MAX/4)
+
+typedef enum{ STAGE_FILTER, STAGE_DAC } stage_t;
+
+typedef struct{
+    lpf_filter lpf;
+    notch_filter notch;
+    bfp_biquad bfp;
+} filter_set;
+
+static double run_filter(const char* name, filter_set* f, UINT32 in, stage_t stage){
+    double y;
+    if(!strcmp(name, "lpf"))        y = lpf_step(&f->lpf, in);
+    else if(!strcmp(name, "notch")) y = notch_step(&f->notch, in);
+    else{
+        INT32 yi = bfp_biquad_step(&f->bfp, in);
+        return stage == STAGE_DAC ? int_to_dac(yi, RES_MAX) : yi;
+    }
+    return stage == STAGE_DAC ? float_to_dac(y, RES_MAX) : y;
+}
+
+static void reset_set(filter_set* f){
+    bfp_biquad bfp = BFP_BIQUAD_INIT(1.0, NOTCH_B1, NOTCH_B2, NOTCH_A1, NOTCH_A2);
+    reset_lpf(&f->lpf);
+    reset_notch(&f->notch);
+    f->bfp = bfp;
+}
+
+    // In-place iterative radix-2 FFT
+static void fft(double* re, double* im, size_t n){
+    size_t i, j, len;
+    for(i = 1, j = 0; i < n; ++i){
+        size_t bit = n >> 1;
+        for(; j & bit; bit >>= 1)   j ^= bit;
+        j ^= bit;
+        if(i < j){
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    for(len = 2; len <= n; len <<= 1){
+        double ang = -2*M_PI/len;
+        for(i = 0; i < n; i += len){
+            for(j = 0; j < len/2; ++j){
+                double wr = cos(ang*j), wi = sin(ang*j);
+                double ur = re[i+j], ui = im[i+j];
+                double vr = re[i+j+len/2]*wr - im[i+j+len/2]*wi;
+                double vi = re[i+j+len/2]*wi + im[i+j+len/2]*wr;
+                re[i+j] = ur + vr;  im[i+j] = ui + vi;
+                re[i+j+len/2] = ur - vr;  im[i+j+len/2] = ui - vi;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv){
+    const char* name = "lpf", *csv = NULL;
+    stage_t stage = STAGE_FILTER;
+    size_t n = 65536, k, settle = 4096, bins;
+    double expect_cutoff = -1, expect_notch = -1, min_depth = -1, tol = 5;
+    double* re, *im, *mag_db, *phase;
+    double dc_db, bin_hz, cutoff = -1, notch_hz = 0, notch_db = 1e9;
+    filter_set ref, imp;
+    int i, failed = 0;
+
+    for(i = 1; i < argc; ++i){
+        if(!strcmp(argv[i], "--stage") && i+1 < argc)
+            stage = strcmp(argv[++i], "dac") ? STAGE_FILTER : STAGE_DAC;
+        else if(!strcmp(argv[i], "--points") && i+1 < argc)    n = strtoul(argv[++i], NULL, 0);
+        else if(!strcmp(argv[i], "--csv") && i+1 < argc)       csv = argv[++i];
+        else if(!strcmp(argv[i], "--expect-cutoff") && i+1 < argc) expect_cutoff = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--expect-notch") && i+1 < argc)  expect_notch = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--min-depth") && i+1 < argc)     min_depth = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--tol") && i+1 < argc)           tol = atof(argv[++i]);
+        else if(argv[i][0] != '-')  name = argv[i];
+        else{
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if(n < 64 || (n & (n-1))){
+        fprintf(stderr, "--points must be a power of 2\n");
+        return 2;
+    }
+
+    re = calloc(n, sizeof(double));
+    im = calloc(n, sizeof(double));
+    mag_db = calloc(n/2 + 1, sizeof(double));
+    phase = calloc(n/2 + 1, sizeof(double));
+
+        // Let both copies settle on mid-scale, then add the impulse to one
+    reset_set(&ref);
+    reset_set(&imp);
+    for(k = 0; k < settle; ++k){
+        run_filter(name, &ref, RES_MAX/2, stage);
+        run_filter(name, &imp, RES_MAX/2, stage);
+    }
+    for(k = 0; k < n; ++k){
+        double a = run_filter(name, &ref, RES_MAX/2, stage);
+        double b = run_filter(name, &imp, RES_MAX/2 + (k == 0 ? IMPULSE : 0), stage);
+        re[k] = (b - a)/IMPULSE;
+        im[k] = 0;
+    }
+    fft(re, im, n);
+
+    bins = n/2;
+    bin_hz = (double)SAMP_FREQ/n;
+    for(k = 0; k <= bins; ++k){
+        double m = hypot(re[k], im[k]);
+        mag_db[k] = 20*log10(m > 1e-15 ? m : 1e-15);
+        phase[k] = atan2(im[k], re[k]);
+        if(k && phase[k] - phase[k-1] > M_PI)       while(phase[k] - phase[k-1] > M_PI)   phase[k] -= 2*M_PI;
+        else if(k && phase[k] - phase[k-1] < -M_PI) while(phase[k] - phase[k-1] < -M_PI)  phase[k] += 2*M_PI;
+    }
+
+    dc_db = mag_db[0];
+    for(k = 1; k <= bins; ++k){
+        if(cutoff < 0 && mag_db[k] < dc_db - 3)   cutoff = k*bin_hz;
+        if(mag_db[k] < notch_db){
+            notch_db = mag_db[k];
+            notch_hz = k*bin_hz;
+        }
+    }
+
+    if(csv){
+        FILE* out = fopen(csv, "w");
+        if(!out){
+            perror(csv);
+            return 2;
+        }
+        fprintf(out, "freq_hz,magnitude_db,phase_deg,group_delay_samples\n");
+        for(k = 0; k <= bins; ++k){
+            size_t lo = k ? k-1 : k, hi = k < bins ? k+1 : k;
+            double gd = -(phase[hi] - phase[lo])/((hi - lo)*2*M_PI/n);
+            fprintf(out, "%.6f,%.4f,%.4f,%.4f\n", k*bin_hz, mag_db[k], phase[k]*180/M_PI, gd);
+        }
+        fclose(out);
+    }
+
+    printf("%s (%s stage, %zu points, %.4f Hz resolution)\n",
+        name, stage == STAGE_DAC ? "dac" : "filter", n, bin_hz);
+    printf("  DC gain          %8.3f dB\n", dc_db);
+    printf("  -3 dB point      %8.3f Hz\n", cutoff);
+    printf("  deepest point    %8.3f Hz, %.2f dB below DC\n", notch_hz, dc_db - notch_db);
+
+    if(expect_cutoff >= 0 && fabs(cutoff - expect_cutoff) > tol){
+        printf("FAIL: -3 dB point %.3f Hz, expected %.3f +- %.3f Hz\n", cutoff, expect_cutoff, tol);
+        failed = 1;
+    }
+    if(expect_notch >= 0 && fabs(notch_hz - expect_notch) > tol){
+        printf("FAIL: notch at %.3f Hz, expected %.3f +- %.3f Hz\n", notch_hz, expect_notch, tol);
+        failed = 1;
+    }
+    if(min_depth >= 0 && dc_db - notch_db < min_depth){
+        printf("FAIL: notch depth %.2f dB, expected at least %.2f dB\n", dc_db - notch_db, min_depth);
+        failed = 1;
+    }
+
+    free(re);
+    free(im);
+    free(mag_db);
+    free(phase);
+    return failed;
+}
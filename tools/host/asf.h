@@ -0,0 +1,18 @@
+#ifndef HOST_ASF_STANDIN_HDR______
+#define HOST_ASF_STANDIN_HDR______
+
+    // Stand-in for the few ASF/CMSIS names that firmware modules built
+    //  into host tools use. Interrupt masking has nothing to protect on
+    //  the host, so it only tracks PRIMASK for code that saves and
+    //  restores it. Do not use for modules that touch peripherals.
+#include <stdint.h>
+#include <stddef.h>
+
+static uint32_t host_primask;
+
+static inline uint32_t __get_PRIMASK(void){ return host_primask; }
+static inline void __set_PRIMASK(uint32_t mask){ host_primask = mask; }
+static inline void __disable_irq(void){ host_primask = 1; }
+static inline void __enable_irq(void){ host_primask = 0; }
+
+#endif
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Generate replay_samples.h, the input table used by REPLAY_INPUT in main.c.
+
+Without an input file a deterministic test signal is written: 50 Hz (in the
+notch), 7 Hz and 180 Hz tones plus pseudo-random noise around mid-scale.
+With --csv the first column of the file is used instead (raw ADC codes),
+e.g. a capture taken from a board.
+
+    python tools/make_replay.py [--csv capture.csv] [--samples 1000] \\
+        [-o replay_samples.h]
+"""
+
+import argparse
+import math
+
+RES_MAX = 4095
+SAMP_FREQ = 1000
+
+
+def synthetic(count):
+    seed = 12345
+    samples = []
+    for n in range(count):
+        t = n/SAMP_FREQ
+            # Fixed LCG so the table never changes between runs
+        seed = (seed*1103515245 + 12345) & 0x7FFFFFFF
+        noise = (seed >> 16) % 41 - 20
+        value = (2048 + 900*math.sin(2*math.pi*50*t)
+                 + 500*math.sin(2*math.pi*7*t)
+                 + 200*math.sin(2*math.pi*180*t) + noise)
+        samples.append(min(max(int(round(value)), 0), RES_MAX))
+    return samples, '50 Hz, 7 Hz and 180 Hz tones with +-20 LSB noise'
+
+
+def from_csv(path, count):
+    samples = []
+    for line in open(path):
+        field = line.split(',')[0].strip()
+        if field.isdigit():
+            samples.append(min(int(field), RES_MAX))
+        if len(samples) == count:
+            break
+    return samples, 'from ' + path
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--csv', help='raw ADC codes, one per line')
+    parser.add_argument('--samples', type=int, default=1000)
+    parser.add_argument('-o', '--output', default='replay_samples.h')
+    args = parser.parse_args()
+
+    if args.csv:
+        samples, source = from_csv(args.csv, args.samples)
+    else:
+        samples, source = synthetic(args.samples)
+
+    with open(args.output, 'w') as out:
+        out.write('#ifndef REPLAY_SAMPLE_TABLE_HDR7730219______\n')
+        out.write('#define REPLAY_SAMPLE_TABLE_HDR7730219______\n\n')
+        out.write('#include "PeriphBoard/extended_types.h"\n\n')
+        out.write('    // Generated by tools/make_replay.py, do not edit.\n')
+        out.write('    //  %d 12-bit samples at %d Hz: %s\n' % (len(samples), SAMP_FREQ, source))
+        out.write('#define REPLAY_SIZE %d\n\n' % len(samples))
+        out.write('static const UINT16 replay_samples[REPLAY_SIZE] = {\n')
+        for i in range(0, len(samples), 12):
+            out.write('    ' + ', '.join('%4d' % s for s in samples[i:i + 12]) + ',\n')
+        out.write('};\n\n#endif\n')
+
+
+if __name__ == '__main__':
+    main()
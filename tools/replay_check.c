@@ -0,0 +1,53 @@
+/*
+    Host reference for the REPLAY_INPUT mode of main.c. Runs the table in
+    replay_samples.h through the firmware filter sources once and prints
+    the FNV-1a hash of the DAC codes, which must equal replay_checksum
+    read from a board built with the same filter selection.
+
+    Build:
+        cc -O2 -I. -IPeriphBoard tools/replay_check.c PeriphBoard/filters.c \
+            PeriphBoard/bfp_filter.c PeriphBoard/utilities.c -o replay_check
+
+    Usage:
+        replay_check [lpf|notch|bfp]
+
+    The host must use single precision float the same way as the target
+    soft-float library (any IEEE 754 host with SSE does); the block
+    floating point path is integer only and always matches.
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include "filters.h"
+#include "bfp_filter.h"
+#include "utilities.h"
+#include "replay_samples.h"
+
+#define RES_MAX 4095
+
+int main(int argc, char** argv){
+    const char* name = argc > 1 ? argv[1] : "lpf";
+    lpf_filter lpf;
+    notch_filter notch;
+    bfp_biquad bfp = BFP_BIQUAD_INIT(1.0, NOTCH_B1, NOTCH_B2, NOTCH_A1, NOTCH_A2);
+    UINT32 hash = FNV1A_INIT;
+    UINT16 i, dac_out;
+
+    reset_lpf(&lpf);
+    reset_notch(&notch);
+    for(i = 0; i < REPLAY_SIZE; ++i){
+        if(!strcmp(name, "lpf"))
+            dac_out = float_to_dac(lpf_step(&lpf, replay_samples[i]), RES_MAX);
+        else if(!strcmp(name, "notch"))
+            dac_out = float_to_dac(notch_step(&notch, replay_samples[i]), RES_MAX);
+        else if(!strcmp(name, "bfp"))
+            dac_out = int_to_dac(bfp_biquad_step(&bfp, replay_samples[i]), RES_MAX);
+        else{
+            fprintf(stderr, "unknown filter %s\n", name);
+            return 2;
+        }
+        hash = fnv1a16(hash, dac_out);
+    }
+    printf("%s replay_checksum 0x%08X\n", name, (unsigned)hash);
+    return 0;
+}
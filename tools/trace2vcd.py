@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Convert a dump of the firmware trace_buffer into a VCD waveform.
+
+Build with TRACE_LOG defined (PeriphBoard/trace_log.h), run, halt and dump
+the buffer, e.g. from gdb:
+
+    dump binary value trace.bin trace_buffer
+
+then convert it and open the result in any VCD viewer (GTKWave, PulseView):
+
+    python tools/trace2vcd.py trace.bin trace.vcd
+"""
+
+import argparse
+import struct
+import sys
+
+TRACE_MAGIC = 0x54524345
+STAMP_MASK = 0xFFFFFF
+
+TC6_ENTER, TC6_EXIT, TC7_ENTER, TC7_EXIT, ADC, DAC, PORTA, PORTB = range(1, 9)
+
+    # Named pins expanded from the port snapshots: (port, bit, name)
+PINS = [('b', i, 'seg_' + n) for i, n in enumerate('abcdefg')] + [
+    ('b', 7, 'seg_dot'),
+    ('b', 9, 'seg_sign'),
+    ('b', 16, 'trace_sample'),
+    ('b', 17, 'trace_dac'),
+] + [('a', 4 + i, 'select%d' % i) for i in range(4)]
+
+
+def read_trace(path):
+    """Return (id, unwrapped cycle stamp, value) in the order written."""
+    data = open(path, 'rb').read()
+    magic, head = struct.unpack_from('<II', data)
+    if magic != TRACE_MAGIC:
+        sys.exit('%s: not a trace_buffer dump (magic %08x)' % (path, magic))
+    size = (len(data) - 8)//8
+    words = struct.unpack_from('<%dI' % (2*size), data, 8)
+    count = min(head, size)
+    first = head - count
+    events, stamp, prev = [], 0, None
+    for n in range(first, head):
+        slot = n % size
+        key, value = words[2*slot], words[2*slot + 1]
+        raw = key & STAMP_MASK
+        if prev is not None:
+            stamp += (raw - prev) & STAMP_MASK
+        prev = raw
+        events.append((key >> 24, stamp, value))
+    return events
+
+
+class VcdWriter:
+    """Minimal VCD writer; only value changes are emitted."""
+
+    def __init__(self, out):
+        self.out = out
+        self.vars = {}
+        self.last = {}
+        self.time = None
+
+    def add(self, key, scope, name, width):
+        code = chr(33 + len(self.vars))
+        self.vars[key] = (scope, name, width, code)
+
+    def header(self, timescale):
+        self.out.write('$timescale %s $end\n' % timescale)
+        scopes = {}
+        for scope, name, width, code in self.vars.values():
+            scopes.setdefault(scope, []).append((name, width, code))
+        for scope, names in scopes.items():
+            self.out.write('$scope module %s $end\n' % scope)
+            for name, width, code in names:
+                self.out.write('$var wire %d %s %s $end\n' % (width, code, name))
+            self.out.write('$upscope $end\n')
+        self.out.write('$enddefinitions $end\n')
+
+    def change(self, time, key, value):
+        if self.last.get(key) == value:
+            return
+        self.last[key] = value
+        if time != self.time:
+            self.out.write('#%d\n' % time)
+            self.time = time
+        _, _, width, code = self.vars[key]
+        if width == 1:
+            self.out.write('%d%s\n' % (value & 1, code))
+        else:
+            self.out.write('b%s %s\n' % (format(value, 'b'), code))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('dump', help='binary dump of trace_buffer')
+    parser.add_argument('vcd', help='output VCD file')
+    parser.add_argument('--clock-hz', type=float, default=8e6,
+                        help='CPU clock the stamps were taken with')
+    args = parser.parse_args()
+
+    events = read_trace(args.dump)
+    ns_per_cycle = 1e9/args.clock_hz
+
+        # Large write buffer so the dump is streamed in few system calls
+    with open(args.vcd, 'w', buffering=1 << 20) as out:
+        vcd = VcdWriter(out)
+        vcd.add('tc6', 'isr', 'tc6_handler', 1)
+        vcd.add('tc7', 'isr', 'tc7_handler', 1)
+        vcd.add(ADC, 'analog', 'adc', 16)
+        vcd.add(DAC, 'analog', 'dac', 10)
+        vcd.add(PORTA, 'port', 'pa_out', 32)
+        vcd.add(PORTB, 'port', 'pb_out', 32)
+        for port, bit, name in PINS:
+            vcd.add((port, bit), 'pins', name, 1)
+        vcd.header('1ns')
+
+        for kind, stamp, value in events:
+            time = int(stamp*ns_per_cycle)
+            if kind in (TC6_ENTER, TC6_EXIT):
+                vcd.change(time, 'tc6', int(kind == TC6_ENTER))
+            elif kind in (TC7_ENTER, TC7_EXIT):
+                vcd.change(time, 'tc7', int(kind == TC7_ENTER))
+            elif kind in (ADC, DAC):
+                vcd.change(time, kind, value)
+            elif kind in (PORTA, PORTB):
+                vcd.change(time, kind, value)
+                port = 'a' if kind == PORTA else 'b'
+                for pin_port, bit, _ in PINS:
+                    if pin_port == port:
+                        vcd.change(time, (port, bit), (value >> bit) & 1)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())